@@ -4,6 +4,7 @@
 #include <utility>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 #include <ZAudio/CommonTypes.h>
 
@@ -31,6 +32,18 @@ enum struct SeekOrigin {
   virtual ~FileInputStream() {}
 };
 
+// reads encoded file kept in memory, for example by SoundCache Compressed sounds
+class MemoryInputStream : public FileInputStream {
+public:
+  explicit MemoryInputStream(std::shared_ptr<const std::vector<uint8_t>> data_p);
+  size_t read(uint8_t* data, size_t n) override;
+  bool seek(size_t pos, SeekOrigin origin) override;
+  std::optional<size_t> tell() override;
+private:
+  std::shared_ptr<const std::vector<uint8_t>> data;
+  size_t position = 0;
+};
+
 class FileOutputStream {
 public:
 enum struct SeekOrigin {
@@ -55,7 +68,7 @@ public:
   WavDecoder& operator= (const WavDecoder& oth) = delete;
   WavDecoder& operator= (WavDecoder&& oth) = default;
 
-  bool get(std::span<sample_t> out) override;
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
   void seek(uint64_t position) override;
   void setLooped(bool looped_p) override;
 
@@ -103,7 +116,7 @@ private:
   FlacDecoder& operator= (const FlacDecoder& oth) = delete;
   FlacDecoder& operator= (FlacDecoder&& oth) = default;
 
-  bool get(std::span<sample_t> out) override;
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
   void seek(uint64_t position) override;
   void setLooped(bool looped_p) override;
 
@@ -140,7 +153,7 @@ public:
   Mp3Decoder& operator= (const Mp3Decoder& oth) = delete;
   Mp3Decoder& operator= (Mp3Decoder&& oth) = default;
 
-  bool get(std::span<sample_t> out) override;
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
   void seek(uint64_t position) override;
   void setLooped(bool looped_p) override;
 
@@ -183,7 +196,7 @@ private:
   VorbisDecoder& operator= (const VorbisDecoder& oth) = delete;
   VorbisDecoder& operator= (VorbisDecoder&& oth) = default;
 
-  bool get(std::span<sample_t> out) override;
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
   void seek(uint64_t position) override;
   void setLooped(bool looped_p) override;
 
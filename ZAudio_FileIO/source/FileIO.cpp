@@ -2,6 +2,9 @@
 #define DR_WAV_IMPLEMENTATION
 #define DR_MP3_IMPLEMENTATION
 
+#include <algorithm>
+#include <array>
+#include <type_traits>
 #include <iostream>
 #include <dr_flac.h>
 #include <dr_mp3.h>
@@ -65,6 +68,29 @@ static drwav_bool32 drWriteOnSeek(void* pUserData, int offset, drwav_seek_origin
   return output->seek(offset, eorigin);
 }
 
+// libraries decode to float, with double sample_t frames are converted through buffer
+template<typename ReadFunction>
+static size_t readFloatFrames(std::span<sample_t> interleaved, size_t frames, size_t channels, ReadFunction readFunction) {
+  if constexpr(std::is_same_v<sample_t, float>) {
+    return readFunction(interleaved.data(), frames);
+  }
+  else {
+    std::array<float, 4096> buffer;
+    const size_t bufferFrames = buffer.size() / channels;
+    size_t done = 0;
+    while(done < frames) {
+      const size_t n = std::min(bufferFrames, frames - done);
+      const size_t got = readFunction(buffer.data(), n);
+      std::copy_n(buffer.cbegin(), got * channels, interleaved.begin() + done * channels);
+      done += got;
+      if(got < n) {
+        break;
+      }
+    }
+    return done;
+  }
+}
+
 static int64_t parse_time(std::string time) {
   int64_t ans;
   try {
@@ -125,6 +151,31 @@ private:
   FILE* file = nullptr;
 };
 
+// MemoryInputStream-----------------------------------------------------------------------------------------
+
+MemoryInputStream::MemoryInputStream(std::shared_ptr<const std::vector<uint8_t>> data_p) : data(std::move(data_p)) {}
+
+size_t MemoryInputStream::read(uint8_t* out, size_t n) {
+  n = std::min(n, data->size() - position);
+  std::copy_n(data->begin() + position, n, out);
+  position += n;
+  return n;
+}
+
+bool MemoryInputStream::seek(size_t pos, SeekOrigin origin) {
+  // negative offsets of dr_libs come converted to size_t, so unsigned wrap-around gives the right position
+  const size_t newPosition = (origin == SeekOrigin::Start ? pos : position + pos);
+  if(newPosition > data->size()) {
+    return false;
+  }
+  position = newPosition;
+  return true;
+}
+
+std::optional<size_t> MemoryInputStream::tell() {
+  return position;
+}
+
 class FileOutputStreamStd : public FileOutputStream {
 public:
   FileOutputStreamStd() = default;
@@ -267,21 +318,20 @@ WavDecoder::~WavDecoder() {
   }
 }
 
-bool WavDecoder::get(std::span<sample_t> out) {
-  std::array<float, Tools::MaxNumberOfChannels> frame;
-  if(drwav_read_pcm_frames_f32(&wav, 1, frame.data()) == 0) {
-    if(looped) {
-      seek(0);
-      if(drwav_read_pcm_frames_f32(&wav, 1, frame.data()) == 0) {
-        return false;
-      }
-    }
-    else {
-      return false;
+size_t WavDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  auto readWav = [this](float* out, size_t n) -> size_t {
+    return drwav_read_pcm_frames_f32(&wav, n, out);
+  };
+  size_t done = readFloatFrames(interleaved, frames, wav.channels, readWav);
+  while(looped && done < frames && !error) {
+    seek(0);
+    const size_t got = readFloatFrames(interleaved.subspan(done * wav.channels), frames - done, wav.channels, readWav);
+    if(got == 0) {
+      break;
     }
+    done += got;
   }
-  std::copy(frame.cbegin(), frame.cend(), out.begin());
-  return true;
+  return done;
 }
 
 void WavDecoder::seek(uint64_t position) {
@@ -379,16 +429,26 @@ FlacDecoder::~FlacDecoder() {
   drflac_close(flac);
 }
 
-bool FlacDecoder::get(std::span<sample_t> out) {
-  std::array<float, Tools::MaxNumberOfChannels> frame;
-  if(looped && getPosition() >= loopEnd) {
-    seek(loopStart);
-  }
-  if(drflac_read_pcm_frames_f32(flac, 1, frame.data()) == 0) {
-    return false;
+size_t FlacDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  auto readFlac = [this](float* out, size_t n) -> size_t {
+    return drflac_read_pcm_frames_f32(flac, n, out);
+  };
+  size_t done = 0;
+  while(done < frames && !error) {
+    size_t n = frames - done;
+    if(looped) {
+      if(getPosition() >= loopEnd) {
+        seek(loopStart);
+      }
+      n = std::min<uint64_t>(n, loopEnd - getPosition());
+    }
+    const size_t got = readFloatFrames(interleaved.subspan(done * flac->channels), n, flac->channels, readFlac);
+    done += got;
+    if(got == 0 || got < n) {
+      break;
+    }
   }
-  std::copy(frame.cbegin(), frame.cend(), out.begin());
-  return true;
+  return done;
 }
 
 void FlacDecoder::seek(uint64_t position) {
@@ -528,21 +588,26 @@ VorbisDecoder::~VorbisDecoder() {
   }
 }
 
-bool VorbisDecoder::get(std::span<sample_t> out) {
-  std::array<float, Tools::MaxNumberOfChannels> frame;
-  if(looped && getPosition() >= loopEnd) {
-    seek(loopStart);
-  }
-  std::array<float*, Tools::MaxNumberOfChannels> buffer;
-  for(size_t i = 0; i < Tools::MaxNumberOfChannels; i++) {
-    buffer[i] = &frame[i];
-  }
-
-  if(stb_vorbis_get_samples_float(vorbis, vorbis->channels, buffer.data(), 1) == 0) {
-    return false;
+size_t VorbisDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  auto readVorbis = [this](float* out, size_t n) -> size_t {
+    return stb_vorbis_get_samples_float_interleaved(vorbis, vorbis->channels, out, n * vorbis->channels);
+  };
+  size_t done = 0;
+  while(done < frames && !error) {
+    size_t n = frames - done;
+    if(looped) {
+      if(getPosition() >= loopEnd) {
+        seek(loopStart);
+      }
+      n = std::min<uint64_t>(n, loopEnd - getPosition());
+    }
+    const size_t got = readFloatFrames(interleaved.subspan(done * vorbis->channels), n, vorbis->channels, readVorbis);
+    done += got;
+    if(got == 0 || got < n) {
+      break;
+    }
   }
-  std::copy(frame.cbegin(), frame.cend(), out.begin());
-  return true;
+  return done;
 }
 
 void VorbisDecoder::seek(uint64_t position) {
@@ -633,19 +698,20 @@ Mp3Decoder::~Mp3Decoder() {
   }
 }
 
-bool Mp3Decoder::get(std::span<sample_t> out) {
-  std::array<float, Tools::MaxNumberOfChannels> frame;
-  if(drmp3_read_pcm_frames_f32(&mp3, 1, frame.data()) == 0) {
-    if(looped) {
-      seek(0);
-      if(drmp3_read_pcm_frames_f32(&mp3, 1, frame.data()) == 0) {
-        return false;
-      }
+size_t Mp3Decoder::read(std::span<sample_t> interleaved, size_t frames) {
+  auto readMp3 = [this](float* out, size_t n) -> size_t {
+    return drmp3_read_pcm_frames_f32(&mp3, n, out);
+  };
+  size_t done = readFloatFrames(interleaved, frames, mp3.channels, readMp3);
+  while(looped && done < frames && !error) {
+    seek(0);
+    const size_t got = readFloatFrames(interleaved.subspan(done * mp3.channels), frames - done, mp3.channels, readMp3);
+    if(got == 0) {
+      break;
     }
-    return false;
+    done += got;
   }
-  std::copy(frame.cbegin(), frame.cend(), out.begin());
-  return true;
+  return done;
 }
 
 void Mp3Decoder::seek(uint64_t position) {
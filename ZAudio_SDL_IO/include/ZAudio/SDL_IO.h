@@ -6,19 +6,22 @@
 #include <ZAudio/AudioOutput.h>
 #include <ZAudio/SampleRateConversion.h>
 #include <ZAudio/CallbackIO.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio {
 
 
 class SDL_Output : public AudioOutput {
 public:
-  SDL_Output(FrameFormat format_p, Frequency inSampleRate_p, SDL_AudioStream* stream_p, std::shared_ptr<std::atomic_bool> stopFlag_p, std::shared_ptr<std::atomic_bool> finishedFlag_p) :
+  SDL_Output(FrameFormat format_p, Frequency inSampleRate_p, SDL_AudioStream* stream_p, std::shared_ptr<std::atomic_bool> stopFlag_p, std::shared_ptr<std::atomic_bool> finishedFlag_p,
+             std::shared_ptr<ThreadTools::RenderSignal> renderSignal_p) :
     format(format_p),
     inSampleRate(inSampleRate_p),
     buffer(128),
     stream(stream_p),
     stopFlag(stopFlag_p),
-    finishedFlag(finishedFlag_p) {}    
+    finishedFlag(finishedFlag_p),
+    renderSignal(renderSignal_p) {}    
 
   void send(std::span<const sample_t> in) override {
     finishedFlag->store(false);
@@ -100,6 +103,18 @@ public:
     return format;
   }
 
+  std::shared_ptr<ThreadTools::RenderSignal> getRenderSignal() override {
+    SDL_AudioSpec spec;
+    int sampleFrames = 0;
+    if(!SDL_GetAudioDeviceFormat(SDL_GetAudioStreamDevice(stream), &spec, &sampleFrames)) {
+      error = true;
+    }
+    // one hardware buffer ahead, rest is requested by stream callback
+    renderSignal->clear();
+    renderSignal->requestFrames(std::max(sampleFrames, static_cast<int>(buffer.size())));
+    return renderSignal;
+  }
+
   // only move constructors
   SDL_Output(const SDL_Output& oth) = delete;
   SDL_Output(SDL_Output&& oth) = default;
@@ -118,6 +133,7 @@ private:
   SDL_AudioStream* stream = nullptr;
   std::shared_ptr<std::atomic_bool> stopFlag;
   std::shared_ptr<std::atomic_bool> finishedFlag;
+  std::shared_ptr<ThreadTools::RenderSignal> renderSignal;
 };
 
 class SDL_Input : public AudioInput {
@@ -219,6 +235,7 @@ private:
 
   std::shared_ptr<std::atomic_bool> stopFlag;
   std::shared_ptr<std::atomic_bool> finishedFlag;
+  std::vector<std::shared_ptr<ThreadTools::RenderSignal>> renderSignals; // used by stream callbacks, so they live as long as SDL audio
 
   std::string error;
 };
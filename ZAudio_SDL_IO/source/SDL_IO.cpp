@@ -23,9 +23,19 @@ bool SDL_IO::init(Frequency sampleRate_p) {
   return true;
 }
 
+// requests frames that device consumed from stream, so engine renders only when device needs them
+static void SDLCALL outputStreamCallback(void* userdata, SDL_AudioStream* stream, int additional_amount, int total_amount) {
+  auto* renderSignal = static_cast<ThreadTools::RenderSignal*>(userdata);
+  SDL_AudioSpec spec;
+  if(total_amount > 0 && SDL_GetAudioStreamFormat(stream, &spec, nullptr) && spec.channels > 0) {
+    renderSignal->requestFrames(total_amount / SDL_AUDIO_FRAMESIZE(spec));
+  }
+}
+
 std::unique_ptr<SDL_Output> SDL_IO::createDefaultOutput(FrameFormat format) {
   SDL_AudioSpec spec = { SDL_AUDIO_F32,  static_cast<int32_t>(ZAudio::Tools::numberOfChannels(format)), static_cast<int32_t>(sampleRate.Hz()) };
-  SDL_AudioStream* outputStream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, nullptr, nullptr);
+  auto renderSignal = std::make_shared<ThreadTools::RenderSignal>();
+  SDL_AudioStream* outputStream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, outputStreamCallback, renderSignal.get());
     
   if(!outputStream) {
     error = SDL_GetError();
@@ -35,7 +45,8 @@ std::unique_ptr<SDL_Output> SDL_IO::createDefaultOutput(FrameFormat format) {
     error = SDL_GetError();
     return nullptr;
   }    
-  return std::make_unique<SDL_Output>(format, sampleRate, outputStream, stopFlag, finishedFlag);
+  renderSignals.push_back(renderSignal);
+  return std::make_unique<SDL_Output>(format, sampleRate, outputStream, stopFlag, finishedFlag, renderSignal);
 }
 
 std::unique_ptr<SDL_Input> SDL_IO::createDefaultInput(FrameFormat format) {
@@ -2,8 +2,9 @@
 
 #include <string>
 #include <array>
+#include <span>
+#include <cassert>
 
-#include <ZAudio/CircularBuffer.h>
 #include <ZAudio/CommonTypes.h>
 
 namespace ZAudio::Tools {
@@ -35,6 +36,15 @@ struct Parameters {
   Volume gain;
   double q = 0.707;  
 };  
+struct Coefficients {
+  static Coefficients create(const Parameters& parameters);
+
+  double a0 = 1;
+  double a1 = 0;
+  double a2 = 0;
+  double b1 = 0;
+  double b2 = 0;
+};
   static constexpr uint32_t NumOfFilterTypes = 10;
   static const inline std::array<std::pair<Type, std::string>, NumOfFilterTypes> typesToStrings = {
     std::make_pair(Type::ByPass, "ByPass"),
@@ -49,31 +59,146 @@ struct Parameters {
     std::make_pair(Type::BandStop, "BandStop")
   };
 
+  // modulated filters recalculate coefficients only once per ControlInterval samples and ramp to them in between
+  static constexpr size_t ControlInterval = 16;
+
   AnalogFilter();
   explicit AnalogFilter(Parameters parameters);
   void reset(Parameters parameters);
+  void setCoefficients(const Coefficients& coefficients_p);
+  void rampTo(const Coefficients& target, size_t frames); // linearly moves coefficients to target during next frames samples
   sample_t process(sample_t in);
+  void process(std::span<const sample_t> in, std::span<sample_t> out); // in and out may be the same span
 
 private:
-  double a0 = 1;
-  double a1 = 0;
-  double a2 = 0;
-  double b1 = 0;
-  double b2 = 0;
+  Coefficients coefficients;
+  Coefficients delta;
+  size_t rampFrames = 0;
+  sample_t x1 = 0.;
+  sample_t x2 = 0.;
+  sample_t y1 = 0.;
+  sample_t y2 = 0.;
+};
+
+// N independent biquads stored lane by lane, one step over all lanes is a plain loop over arrays which compiler vectorizes
+template<size_t N>
+class AnalogFilterBank {
+public:
+  AnalogFilterBank() {
+    a0.fill(1.);
+    a1.fill(0.);
+    a2.fill(0.);
+    b1.fill(0.);
+    b2.fill(0.);
+    x1.fill(0.);
+    x2.fill(0.);
+    y1.fill(0.);
+    y2.fill(0.);
+  }
+
+  void reset(size_t lane, AnalogFilter::Parameters parameters) {
+    setCoefficients(lane, AnalogFilter::Coefficients::create(parameters));
+  }
+
+  void setCoefficients(size_t lane, const AnalogFilter::Coefficients& coefficients) {
+    assert(lane < N);
+    a0[lane] = coefficients.a0;
+    a1[lane] = coefficients.a1;
+    a2[lane] = coefficients.a2;
+    b1[lane] = coefficients.b1;
+    b2[lane] = coefficients.b2;
+    rampFrames = 0;
+  }
+
+  // all lanes move linearly to their targets during next frames samples
+  void rampTo(const std::array<AnalogFilter::Coefficients, N>& targets, size_t frames) {
+    if(frames == 0) {
+      for(size_t i = 0; i < N; i++) {
+        setCoefficients(i, targets[i]);
+      }
+      return;
+    }
+    for(size_t i = 0; i < N; i++) {
+      da0[i] = (targets[i].a0 - a0[i]) / frames;
+      da1[i] = (targets[i].a1 - a1[i]) / frames;
+      da2[i] = (targets[i].a2 - a2[i]) / frames;
+      db1[i] = (targets[i].b1 - b1[i]) / frames;
+      db2[i] = (targets[i].b2 - b2[i]) / frames;
+    }
+    rampFrames = frames;
+  }
+
+  // one sample for every lane
+  void process(std::array<sample_t, N>& frame) {
+    if(rampFrames > 0) {
+      stepRamp();
+    }
+    for(size_t i = 0; i < N; i++) {
+      frame[i] = step(i, frame[i]);
+    }
+  }
+
+  // every lane filters its own channel, in and out channels may be the same
+  void process(const std::array<std::span<const sample_t>, N>& in, const std::array<std::span<sample_t>, N>& out, size_t frames) {
+    std::array<sample_t, N> frame;
+    for(size_t x = 0; x < frames; x++) {
+      for(size_t i = 0; i < N; i++) {
+        frame[i] = in[i][x];
+      }
+      process(frame);
+      for(size_t i = 0; i < N; i++) {
+        out[i][x] = frame[i];
+      }
+    }
+  }
+
+  // lanes connected in series, lane 0 first
+  sample_t processCascade(sample_t in) {
+    if(rampFrames > 0) {
+      stepRamp();
+    }
+    for(size_t i = 0; i < N; i++) {
+      in = step(i, in);
+    }
+    return in;
+  }
+
+private:
+  std::array<double, N> a0;
+  std::array<double, N> a1;
+  std::array<double, N> a2;
+  std::array<double, N> b1;
+  std::array<double, N> b2;
+  std::array<sample_t, N> x1;
+  std::array<sample_t, N> x2;
+  std::array<sample_t, N> y1;
+  std::array<sample_t, N> y2;
+  std::array<double, N> da0;
+  std::array<double, N> da1;
+  std::array<double, N> da2;
+  std::array<double, N> db1;
+  std::array<double, N> db2;
+  size_t rampFrames = 0;
+
+  void stepRamp() {
+    for(size_t i = 0; i < N; i++) {
+      a0[i] += da0[i];
+      a1[i] += da1[i];
+      a2[i] += da2[i];
+      b1[i] += db1[i];
+      b2[i] += db2[i];
+    }
+    rampFrames--;
+  }
 
-  CircularBuffer<sample_t> aDelay; 
-  CircularBuffer<sample_t> bDelay;
-
-  void setByPass();
-  void setAllPass(Frequency sampleRate, Frequency frequency);
-  void setFirstOrderLowPass(Frequency sampleRate, Frequency frequency);
-  void setFirstOrderHighPass(Frequency sampleRate, Frequency frequency);
-  void setLowPass(Frequency sampleRate, Frequency frequency, double q);
-  void setHighPass(Frequency sampleRate, Frequency frequency, double q);
-  void setLowShelf(Frequency sampleRate, Frequency frequency, Volume gain);
-  void setHighShelf(Frequency sampleRate, Frequency frequency, Volume gain);
-  void setBandPass(Frequency sampleRate, Frequency frequency, double q);
-  void setBandStop(Frequency sampleRate, Frequency frequency, double q);
+  sample_t step(size_t i, sample_t in) {
+    const sample_t out = in * a0[i] + x1[i] * a1[i] + x2[i] * a2[i] - y1[i] * b1[i] - y2[i] * b2[i];
+    x2[i] = x1[i];
+    x1[i] = in;
+    y2[i] = y1[i];
+    y1[i] = out;
+    return out;
+  }
 };
 
 
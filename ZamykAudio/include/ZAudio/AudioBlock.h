@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include <ZAudio/CommonTypes.h>
+#include <ZAudio/FrameFormat.h>
+#include <ZAudio/TwoDimVector.h>
+
+namespace ZAudio {
+
+
+// non owning view of planar samples, every channel is separate span of the same length
+class AudioBlockView {
+public:
+  AudioBlockView() = default;
+  explicit AudioBlockView(std::span<sample_t> channel);
+  AudioBlockView(std::span<sample_t> left, std::span<sample_t> right);
+
+  std::span<sample_t> getChannel(size_t channel) const {
+    assert(channel < numberOfChannels);
+    return channels[channel];
+  }
+
+  size_t getNumberOfChannels() const;
+  size_t getLength() const;
+  AudioBlockView subView(size_t offset, size_t length) const;
+
+  void getFrame(size_t x, std::span<sample_t> out) const;
+  void setFrame(size_t x, std::span<const sample_t> in) const;
+  void clear() const;
+
+private:
+  std::array<std::span<sample_t>, Tools::MaxNumberOfChannels> channels;
+  size_t numberOfChannels = 0;
+};
+
+// owning storage for AudioBlockView, always holds MaxNumberOfChannels channels so it can be viewed in any format
+class AudioBlock {
+public:
+  AudioBlock() = default;
+  explicit AudioBlock(size_t length);
+
+  void resize(size_t length);
+  void reserve(size_t length); // resizes only if block is shorter than length
+  size_t getLength() const;
+
+  AudioBlockView getView(FrameFormat format);
+  AudioBlockView getView(FrameFormat format, size_t length);
+
+private:
+  Tools::TwoDimVector<sample_t> samples;
+};
+
+
+} // namespace ZAudio
+
+namespace ZAudio::Tools {
+
+void convertBlock(const AudioBlockView& in, FrameFormat inFormat, const AudioBlockView& out, FrameFormat outFormat, size_t frames);
+
+
+} // namespace ZAudio::Tools
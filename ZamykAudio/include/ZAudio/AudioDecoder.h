@@ -1,17 +1,26 @@
 #pragma once
 
+#include <atomic>
+#include <vector>
+
 #include <ZAudio/AudioInput.h>
 #include <ZAudio/SoundBuffer.h>
 #include <ZAudio/SampleRateConversion.h>
 #include <ZAudio/ReaderWriterQueue.h>
 #include <ZAudio/Smoother.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio {
 
 class AudioDecoder {
 public:
   virtual ~AudioDecoder() = default;
-  virtual bool get(std::span<sample_t> out) = 0;
+  // reads frames interleaved frames, returns number of read frames, it's less than frames only at the end of sound or after error
+  // looped decoder continues from loop start
+  virtual size_t read(std::span<sample_t> interleaved, size_t frames) = 0;
+  bool get(std::span<sample_t> out) {
+    return read(out, 1) == 1;
+  }
   virtual void seek(uint64_t position) = 0;
   virtual uint64_t getLength() = 0;
   virtual Frequency getSampleRate() = 0;
@@ -31,12 +40,19 @@ public:
   virtual FrameFormat getFormat() const = 0;
 };
 
-class AsyncDecoder : public AudioDecoder {
+// decodes on IOExecutor threads to ring buffer of bufferedTime, so read never waits for decoder
+// it's refilled when buffer falls below half, read, seek and setLooped have to be called from one thread (usually the audio thread)
+// when buffer is empty read gives silence and counts underrun, after seek it gives silence until decoder seeks
+class AsyncDecoder : public AudioDecoder, private ThreadTools::IOExecutor::Stream {
 public:
-  AsyncDecoder(std::unique_ptr<AudioDecoder> decoder_p, Time bufferedTime, bool looped_p = false);
+  static constexpr size_t BlockFrames = 1024;  // frames decoded and moved to buffer at once
+  static constexpr size_t ServiceBlocks = 4;   // blocks decoded before executor serves more urgent stream
+
+  // executor nullptr is IOExecutor::getShared()
+  AsyncDecoder(std::unique_ptr<AudioDecoder> decoder_p, Time bufferedTime, bool looped_p = false, ThreadTools::IOExecutor* executor_p = nullptr);
   ~AsyncDecoder();
 
-  bool get(std::span<sample_t> out) override;
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
   void seek(uint64_t position) override;
   void setLooped(bool looped_p) override;
 
@@ -49,6 +65,9 @@ public:
   bool errorOccured() const override;
   FrameFormat getFormat() const override;
 
+  uint64_t getUnderruns() const;
+  size_t getBufferedFrames() const;
+
   // no copyable or movable
   AsyncDecoder(AsyncDecoder& oth) = delete;
   AsyncDecoder& operator= (AsyncDecoder& oth) = delete;
@@ -56,30 +75,44 @@ public:
 private:
   std::unique_ptr<AudioDecoder> decoder;
   Tools::ReaderWriterQueue<sample_t> buffer;
-  std::atomic_bool run{false};
-  std::atomic_bool ready{false};
+  size_t lowWatermark = 0; // samples
 
   // these won't change, no need for atomic
-  uint32_t length = 0;
+  uint64_t length = 0;
   Frequency sampleRate;
   FrameFormat format;
-  uint32_t loopStart = 0;
-  uint32_t loopEnd = 0;
-
-  std::atomic_bool ended{false};
+  size_t numberOfChannels = 0;
+  uint64_t loopStart = 0;
+  uint64_t loopEnd = 0;
+
+  // decoder thread side
+  std::vector<sample_t> pending;  // decoded block, that didn't fit to buffer yet
+  size_t pendingOffset = 0;
+  bool decoderEnded = false;
+  uint64_t pushed = 0;            // samples pushed since start
+
+  // reader side
+  uint64_t popped = 0;            // samples popped or discarded since start
+  uint64_t position = 0;
+  std::atomic_uint64_t underruns{0};
+
+  std::atomic_bool ended{false};  // all samples up to end of sound are in buffer
   std::atomic_bool error{false};
-
-  std::atomic_uint32_t position = 0;
-
-  std::atomic_uint32_t seekPosition = 0;
-  std::atomic_bool askSeek{false};
-
   std::atomic_bool looped{false};
   std::atomic_bool askSetLooped{false};
 
-  std::thread thread;
+  // samples pushed before seek was done are discarded by reader
+  std::atomic_uint64_t seekPosition{0};
+  std::atomic_uint32_t seekRequest{0};
+  std::atomic_uint32_t seekDone{0};
+  std::atomic_uint64_t seekDonePushed{0};
+
+  ThreadTools::IOExecutor* executor = nullptr;
 
-  void asyncThread();
+  double getBufferedSeconds() const override;
+  bool service() override;
+  void requestRefill();
+  bool refill(size_t limit); // pushes at most limit samples, returns true if buffer can take more
 };
 
 ResultValue<SoundBuffer> decodeSound(AudioDecoder& decoder);
@@ -115,7 +148,7 @@ struct Parameters {
 private:
   Frequency sampleRate;
   std::unique_ptr<AudioDecoder> decoder;
-  std::vector<Tools::SampleRateConverter> sampleRateConverters;
+  Tools::Resampler resampler;
   bool playing = true;
   bool ended = false;
   bool looped = false;
@@ -1,10 +1,11 @@
 #pragma once
 
-#include <thread>
+#include <atomic>
 #include <ZAudio/AudioOutput.h>
 #include <ZAudio/SoundBuffer.h>
 #include <ZAudio/SampleRateConversion.h>
 #include <ZAudio/ReaderWriterQueue.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio {
 
@@ -19,9 +20,15 @@ public:
   virtual bool ended() const = 0;
 };
 
-class AsyncEncoder : public AudioEncoder {
+// encodes on IOExecutor threads from ring buffer of bufferedTime, send waits only when buffer is full
+// samples left in buffer are encoded in destructor
+class AsyncEncoder : public AudioEncoder, private ThreadTools::IOExecutor::Stream {
 public:
-  AsyncEncoder(std::unique_ptr<AudioEncoder> encoder_p, Time bufferedTime);
+  static constexpr size_t BlockFrames = 1024;  // executor is asked to drain buffer when it has this many frames
+  static constexpr size_t ServiceBlocks = 4;   // blocks encoded before executor serves more urgent stream
+
+  // executor nullptr is IOExecutor::getShared()
+  AsyncEncoder(std::unique_ptr<AudioEncoder> encoder_p, Time bufferedTime, ThreadTools::IOExecutor* executor_p = nullptr);
   ~AsyncEncoder();
   void send(std::span<const sample_t> out) override;
   Frequency getSampleRate() const override;
@@ -31,18 +38,21 @@ public:
 private:
   std::unique_ptr<AudioEncoder> encoder;
   Tools::ReaderWriterQueue<sample_t> buffer;
-  std::atomic_bool run{false};
-  std::atomic_bool ready{false};
 
   // these won't change, no need for atomic
   Frequency sampleRate;
   FrameFormat format;
+  size_t numberOfChannels = 0;
 
   std::atomic_bool ended_{false};
   std::atomic_bool error{false};
 
-  std::thread thread;
-  void asyncThread();
+  ThreadTools::IOExecutor* executor = nullptr;
+  std::vector<sample_t> block; // used only by executor
+
+  double getBufferedSeconds() const override;
+  bool service() override;
+  void drain(size_t limit); // encodes at most limit frames
 };
 
 Result encodeSound(AudioEncoder& encoder, const SoundBuffer& soundBuffer);
@@ -63,7 +73,7 @@ enum : uint32_t {
 private:
   std::unique_ptr<AudioEncoder> encoder;    
   Frequency sampleRate;
-  std::vector<Tools::SampleRateConverter> sampleRateConverters;
+  Tools::Resampler resampler;
   bool stop = false;
 };
 
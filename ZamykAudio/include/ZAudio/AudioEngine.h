@@ -1,14 +1,21 @@
 #pragma once
 
 #include <thread>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
 #include <variant>
+#include <vector>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/Effect.h>
 #include <ZAudio/BypassEffect.h>
 #include <ZAudio/AudioInput.h>
 #include <ZAudio/AudioOutput.h>
-#include <ZAudio/ReaderWriterQueue.h>
+#include <ZAudio/MPSCQueue.h>
 #include <ZAudio/CircularBuffer.h>
 #include <ZAudio/ThreadTools.h>
 
@@ -20,6 +27,88 @@ class AudioEngine; // forward
 class AudioEngineInput; // forward
 class AudioEngineOutput; // forward
 
+// state of input, output or effect that engine publishes after every block, so it can be read without waiting for engine thread
+// it's used only if engine handled all commands with its handle, that were pushed before, otherwise query goes through command queue
+class PublishedState {
+public:
+  static constexpr size_t MaxValues = 16; // output values with lower ids are published after they are asked for the first time
+
+struct Snapshot {
+  bool published = false; // false while engine doesn't play input (or didn't add output or effect yet)
+  bool playing = false;
+  bool ended = false;
+  uint64_t handledCommands = 0;
+};
+
+  PublishedState() = default;
+  PublishedState(const PublishedState&) = delete;
+  PublishedState& operator = (const PublishedState&) = delete;
+
+  // caller side
+  void commandPushed() {
+    pushedCommands++;
+  }
+
+  void commandDropped() {
+    pushedCommands--;
+  }
+
+  std::optional<Snapshot> getSnapshot() const {
+    const Snapshot ans = snapshot.load();
+    if(ans.handledCommands < pushedCommands) {
+      return std::nullopt;
+    }
+    return ans;
+  }
+
+  std::optional<ParameterValue> getValue(size_t id) {
+    if(id >= MaxValues) {
+      return std::nullopt;
+    }
+    watched[id] = true;
+    const auto state = getSnapshot();
+    if(!state || !state->published) {
+      return std::nullopt;
+    }
+    const Value value = values[id].load();
+    if(!value.valid) {
+      return std::nullopt;
+    }
+    return value.value;
+  }
+
+  // engine side
+  void commandHandled() {
+    handledCommands++;
+  }
+
+  // values are stored before snapshot, so reader that sees new snapshot sees at least as new values
+  template<typename F>
+  void publish(bool playing, bool ended, F&& getValue) {
+    for(size_t id = 0; id < MaxValues; id++) {
+      if(watched[id]) {
+        values[id].store({getValue(id), true});
+      }
+    }
+    snapshot.store({true, playing, ended, handledCommands});
+  }
+
+  void unpublish() {
+    snapshot.store({false, false, false, handledCommands});
+  }
+
+private:
+struct Value {
+  ParameterValue value;
+  bool valid = false;
+};
+  std::atomic_uint64_t pushedCommands{0};
+  uint64_t handledCommands = 0; // only engine thread
+  ThreadTools::SeqLock<Snapshot> snapshot;
+  std::array<std::atomic_bool, MaxValues> watched{};
+  std::array<ThreadTools::SeqLock<Value>, MaxValues> values;
+};
+
 template<typename T, typename ID>
 class THandleID {
 public:
@@ -41,10 +130,12 @@ private:
 
   std::shared_ptr<T> ptr;
   ID id;
+  std::shared_ptr<PublishedState> state;
 
   THandleID(ID id_p, std::shared_ptr<T> ptr_p) :
     ptr(ptr_p),
-    id(id_p) {}
+    id(id_p),
+    state(std::make_shared<PublishedState>()) {}
 
   T& get() {
     return *ptr;
@@ -72,6 +163,7 @@ private:
   friend Mixer;
   friend AudioEngine;
   std::shared_ptr<T> ptr;
+  std::shared_ptr<PublishedState> state;
 
   THandle(std::shared_ptr<T> ptr_p) :
     ptr(ptr_p) {}
@@ -129,10 +221,11 @@ public:
   AudioEngineInput() = default;
   AudioEngineInput(InputHandle handle_p);
 
-  void get(std::span<sample_t> out);
+  AudioBlockView get(size_t frames);
   void resetCached();
 
   AudioInput& getInput();
+  InputHandle& getHandle();
   int32_t getUseCount() const;
   void incrementUseCount();
   void decrementUseCount();
@@ -144,7 +237,7 @@ private:
   InputHandle handle;
   int32_t useCount = 0;
 
-  std::array<sample_t, Tools::MaxNumberOfChannels> cachedFrame;
+  AudioBlock cachedBlock;
   bool cached = false;
 };
 
@@ -153,8 +246,8 @@ public:
   AudioEngineOutput() = default;
   AudioEngineOutput(OutputHandle handle_p);
 
-  void send(std::span<const sample_t> out);
-  void finishedFrame();
+  void send(const AudioBlockView& out, size_t frames);
+  void finishedBlock(size_t frames);
 
   OutputHandle& getOutput();
   int32_t getUseCount() const;
@@ -166,7 +259,7 @@ private:
   OutputHandle handle;
   int32_t useCount = 0;
 
-  std::array<sample_t, Tools::MaxNumberOfChannels> cachedFrame;
+  AudioBlock cachedBlock;
 };
 
 
@@ -179,12 +272,22 @@ public:
 
   void add(AudioEngineInputID input, EffectHandle effect_p);
   void stop(AudioEngineInputID input);
-  void get(std::span<sample_t> out);
+  void get(const AudioBlockView& out, size_t frames);
   bool errorOccured() const;
   bool isPlaying() const;
   FrameFormat getFormat() const;
   int32_t getTotalPlaying() const;
 
+  // get split into steps, processInput of diffrent inputs can run in parallel, mix must be called after all of them
+  // and removeEnded after mix (it is not safe to run in parallel with other mixers sharing inputs)
+  size_t getNumberOfInputs() const;
+  AudioEngineInput& getInput(size_t index);
+  const Effect* getInputEffect(size_t index) const;
+  void getMixEffects(std::vector<const Effect*>& effects) const; // effects used by mix (mixer effect and tails)
+  void processInput(size_t index, size_t frames);
+  void mix(const AudioBlockView& out, size_t frames);
+  void removeEnded();
+
 private:
   std::unordered_map<AudioEngineInputID, AudioEngineInput>* inputs;
   FrameFormat format;
@@ -193,7 +296,9 @@ private:
     AudioEngineInputID input;
     EffectHandle effect;
     bool playing = true;
+    bool error = false;
     uint32_t timeRemaining = 0;
+    AudioBlock block;
   };
 
   struct TailEffect {
@@ -207,14 +312,43 @@ private:
 
   EffectHandle mixerEffect;
   bool error = false;
+
+  AudioBlock block1;
+  AudioBlock block2;
+  AudioBlock sumBlock;
 };
 
 
 class AudioEngine {
 public:
-  AudioEngine(Frequency sampleRate_p, int32_t simultaneousPlayingLimit_p = 20);
+  static constexpr size_t DefaultBlockSize = 128;
+
+// what happens with command when command queue is full (queries always wait)
+enum struct QueuePolicy {
+  Block,          // calling thread waits until engine handles some commands
+  Drop,           // parameter command is dropped and counted, other commands wait
+  OverwriteLatest // parameter commands are kept aside, only the latest value of every parameter, other commands wait (or are kept aside after them, at most queue size of them)
+};
+
+struct Parameters {
+  int32_t simultaneousPlayingLimit = 20;
+  size_t blockSize = DefaultBlockSize;
+  size_t workerThreads = 0;
+  bool offline = false; // no engine thread, audio is rendered only by render called from user thread
+  QueuePolicy queuePolicy = QueuePolicy::Block;
+
+  Parameters(int32_t simultaneousPlayingLimit_p = 20, size_t blockSize_p = DefaultBlockSize, size_t workerThreads_p = 0, bool offline_p = false, QueuePolicy queuePolicy_p = QueuePolicy::Block);
+};
+
+  class CommandBatch;
+
+  AudioEngine(Frequency sampleRate_p, int32_t simultaneousPlayingLimit_p = 20, size_t blockSize_p = DefaultBlockSize, size_t workerThreads_p = 0);
+  AudioEngine(Frequency sampleRate_p, const Parameters& parameters);
   ~AudioEngine();
 
+  // only in offline mode, renders frames frames to outputs as fast as possible
+  void render(size_t frames);
+
   MixerHandle addMixer(FrameFormat format);
   MixerHandle addMixer(EffectHandle effect);
   void addMixerOutput(const MixerHandle& input, const OutputHandle& output);
@@ -223,18 +357,29 @@ public:
   void play(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect);
   void play(const MixerHandle& mixer, const InputHandle& input);
   void stop(const MixerHandle& mixer, const InputHandle& input);
+  // scheduled versions take effect exactly at frame of engine clock (getFrame), block is split there, frame that already passed means now
+  void playAt(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect, uint64_t frame);
+  void playAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame);
+  void stopAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame);
   EffectHandle addEffect(std::unique_ptr<Effect> effect);
-  void setEffectParameter(const EffectHandle& handle, size_t parameterID, const ParameterValue& v);
-  void setMultiEffectParameter(const EffectHandle& handle, size_t effectID, size_t parameterID, const ParameterValue& v);
+  // with frame parameter is set exactly at that frame of engine clock like playAt, so automation doesn't depend on block size
+  void setEffectParameter(const EffectHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
+  void setMultiEffectParameter(const EffectHandle& handle, size_t effectID, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
   InputHandle addInput(std::unique_ptr<AudioInput> input);
-  void setInputParameter(const InputHandle& handle, size_t parameterID, const ParameterValue& v );
+  void setInputParameter(const InputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
   OutputHandle addOutput(std::unique_ptr<AudioOutput> output);
-  void setOutputParameter(const OutputHandle& handle, size_t parameterID, const ParameterValue& v);
+  void setOutputParameter(const OutputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
+  // all commands of batch are handled at once between blocks, batch takes one place in command queue
+  void submit(CommandBatch batch);
   bool isPlaying(const InputHandle& handle);
   bool hasEnded(const OutputHandle& handle);
   ParameterValue getOutputValue(const InputHandle& handle, size_t id);
   ParameterValue getOutputValue(const OutputHandle& handle, size_t id);
   ParameterValue getOutputValue(const EffectHandle& handle, size_t id);
+  size_t getBlockSize() const;
+  size_t getNumberOfWorkerThreads() const;
+  uint64_t getFrame() const; // number of frames engine rendered since it was created, it only grows
+  uint64_t getNumberOfDroppedCommands() const; // with QueuePolicy::Drop
 
   template<typename T, typename... Args>
   EffectHandle addEffect(Args&&... args) {
@@ -271,31 +416,69 @@ struct Command {
     GetAudioInputOutputValue,
     GetAudioOutputOutputValue,
     GetEffectOutputValue,
-    AskHasEnded
+    AskHasEnded,
+    Batch
   };
   size_t ind1 = 0;
   size_t ind2 = 0;
   std::variant<MixerHandle, InputHandle, OutputHandle, EffectHandle> handle;
   std::variant<MixerHandle, InputHandle, OutputHandle, EffectHandle, ParameterValue> value1;
   std::variant<MixerHandle, InputHandle, OutputHandle, EffectHandle, ParameterValue> value2;
+  std::vector<Command> batch;
+  uint64_t frame = 0; // frame of engine clock when command is handled
+  // queries are answered to caller stack
+  ParameterValue* response = nullptr;
+  std::atomic_bool* responded = nullptr;
   Type type;
 };
   static constexpr uint32_t QueueSize = 256;
-  static constexpr uint32_t OutQueueSize = 2;
-  Tools::ReaderWriterQueue<Command> queue;
-  Tools::ReaderWriterQueue<ParameterValue> outQueue;
+  Tools::MPSCQueue<Command> queue;
+  QueuePolicy queuePolicy = QueuePolicy::Block;
+  std::atomic<uint64_t> droppedCommands{0};
+
+  // parameter commands that didn't fit to queue with QueuePolicy::OverwriteLatest, and all commands sent after them until engine takes them
+  std::mutex overflowMutex;
+  std::unique_ptr<CommandBatch> overflow;
+  std::atomic_bool overflowPending{false};
+  std::unique_ptr<CommandBatch> handledOverflow; // only engine thread
+
+  std::vector<Command> scheduled; // commands for frames that weren't rendered yet, the earliest at the back
 
   std::vector<MixerHandle> mixers;
   std::vector<EffectHandle> effects;
 
   std::unordered_map<AudioEngineInputID, AudioEngineInput> inputs;
   std::unordered_map<AudioEngineOutputID, AudioEngineOutput> outputs;
-  uint64_t nextID = 0;
+  std::atomic<uint64_t> nextID{0};
 
   std::vector<std::pair<MixerHandle, AudioEngineOutputID>> mixersOutputs;
 
+  struct RenderedMixer {
+    Mixer* mixer = nullptr;
+    AudioBlock block;
+  };
+  std::vector<RenderedMixer> renderedMixers; // mixers that have at least one output, each is rendered once per block
+  std::vector<AudioEngineInput*> renderedInputs;
+  std::vector<std::pair<Mixer*, size_t>> renderedMixerInputs;
+  // the same effect can be used by several inputs or mixers, tasks sharing an effect run in one group on one thread
+  std::vector<size_t> renderedGroups; // start of every group and end of the last one
+  std::vector<size_t> renderedMixerOrder;
+  std::vector<size_t> mixerGroupParent;
+  std::vector<std::pair<const Effect*, size_t>> mixEffects;
+  std::vector<const Effect*> mixerEffects;
+  AudioBlock outputBlock;
+
   Frequency sampleRate;
   int32_t simultaneousPlayingLimit = 0;
+  size_t blockSize = DefaultBlockSize;
+  bool offline = false;
+  ThreadTools::WorkerPool workers;
+
+  std::shared_ptr<ThreadTools::RenderSignal> clock;
+  std::atomic<ThreadTools::RenderSignal*> clockSignal{nullptr};
+  std::chrono::steady_clock::time_point clockStart;
+  std::atomic<uint64_t> renderedFrames{0};
+  size_t pendingFrames = 0;
 
   std::atomic_bool run{true};
   std::atomic_bool ready{false};
@@ -315,12 +498,30 @@ struct Command {
   void setInputParameter(Command& command);
   void setOutputParameter(Command& command);
   void setMultiEffectParameter(Command& command);
-  void askIsPlaying(Command& command);
-  void getAudioInputOutputValue(Command& command);
-  void getAudioOutputOutputValue(Command& command);
-  void getEffectOutputValue(Command& command);
-  void askHasEnded(Command& command);
+  ParameterValue askIsPlaying(Command& command);
+  ParameterValue getAudioInputOutputValue(Command& command);
+  ParameterValue getAudioOutputOutputValue(Command& command);
+  ParameterValue getEffectOutputValue(Command& command);
+  ParameterValue askHasEnded(Command& command);
+  template<typename F>
+  static void forEachState(Command& command, F&& function);
+  static bool isParameterCommand(const Command& command);
   void handleCommand(Command& command);
+  void runCommand(Command& command);
+  void runScheduledCommands();
+  size_t getFramesToScheduled() const;
+  ParameterValue handleQuery(Command& command);
+  void pushCommand(Command& command);
+  void pushOverflow(Command& command);
+  void handleOverflow();
+  ParameterValue pushQuery(Command& command);
+  void removeUnusedInputs();
+  void publishState();
+  void updateRenderedMixers();
+  size_t waitForFrames();
+  void renderBlock(size_t frames);
+  template<class F>
+  void groupRendered(size_t count, F key); // consecutive tasks with the same key form a group
   void engineThread();
 
   template<typename T>
@@ -329,5 +530,43 @@ struct Command {
   }
 };
 
+// records commands on calling thread, they are handled when batch is submitted to engine
+// setting the same parameter again drops its earlier recorded value, so only the last one is sent
+class AudioEngine::CommandBatch {
+public:
+  void addMixerOutput(const MixerHandle& mixer, const OutputHandle& output);
+  void removeMixerOutput(const MixerHandle& mixer, const OutputHandle& output);
+  void setMixerEffect(const MixerHandle& mixer, const EffectHandle& effect);
+  void play(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect);
+  void play(const MixerHandle& mixer, const InputHandle& input);
+  void stop(const MixerHandle& mixer, const InputHandle& input);
+  void playAt(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect, uint64_t frame);
+  void playAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame);
+  void stopAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame);
+  void setEffectParameter(const EffectHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
+  void setMultiEffectParameter(const EffectHandle& handle, size_t effectID, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
+  void setInputParameter(const InputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
+  void setOutputParameter(const OutputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame = 0);
+
+  size_t size() const;
+  bool empty() const;
+  void clear();
+
+private:
+  friend AudioEngine;
+  using ParameterKey = std::tuple<Command::Type, const void*, size_t, size_t, uint64_t>;
+
+  std::vector<Command> commands;
+  std::vector<bool> dropped;
+  size_t droppedCommands = 0;
+  std::map<ParameterKey, size_t> parameters; // index of command that sets parameter
+
+  static ParameterKey getParameterKey(const Command& command);
+  bool hasParameter(const Command& command) const;
+  void add(Command command);
+  void setParameter(Command command);
+  void compact();
+};
+
 
 } // namespace ZAudio
\ No newline at end of file
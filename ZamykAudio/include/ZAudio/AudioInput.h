@@ -2,6 +2,7 @@
 
 #include <string>
 #include <span>
+#include <ZAudio/AudioBlock.h>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/FrameFormat.h>
 
@@ -12,6 +13,16 @@ class AudioInput {
 public:
   virtual ~AudioInput() = default;
   virtual void get(std::span<sample_t> out) = 0;
+
+  virtual void getBlock(const AudioBlockView& out, size_t frames) {
+    std::array<sample_t, Tools::MaxNumberOfChannels> frame;
+    for(size_t i = 0; i < frames; i++) {
+      out.getFrame(i, frame);
+      get(frame);
+      out.setFrame(i, frame);
+    }
+  }
+
   virtual void setSampleRate(Frequency sampleRate) = 0;
   virtual void setParameter(size_t id, ParameterValue value) {}
   virtual ParameterValue getOutputValue(size_t id) const { return ParameterValue(); }  
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <ZAudio/AudioBlock.h>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/FrameFormat.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio {
 
@@ -11,12 +14,25 @@ class AudioOutput {
 public:
   virtual ~AudioOutput() {}  
   virtual void send(std::span<const sample_t> in) = 0;
+
+  virtual void sendBlock(const AudioBlockView& in, size_t frames) {
+    std::array<sample_t, Tools::MaxNumberOfChannels> frame;
+    for(size_t i = 0; i < frames; i++) {
+      in.getFrame(i, frame);
+      send(frame);
+    }
+  }
+
   virtual void setSampleRate(Frequency sampleRate) = 0;
   virtual void setParameter(size_t id, ParameterValue value) {}
   virtual ParameterValue getOutputValue(size_t id) { return ParameterValue(); }
   virtual bool errorOccured() const = 0;
   virtual bool ended() const = 0;  
   virtual FrameFormat getFormat() const = 0;
+
+  // outputs driven by audio device return signal through which device requests frames, AudioEngine then renders only requested frames
+  // (called after setSampleRate)
+  virtual std::shared_ptr<ThreadTools::RenderSignal> getRenderSignal() { return nullptr; }
 };
 
 
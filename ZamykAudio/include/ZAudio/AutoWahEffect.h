@@ -60,6 +60,7 @@ private:
   Frequency currFrequency;
   Tools::AudioDetector detector;  
   Tools::AnalogFilter bandPass;    
+  size_t controlCounter = 0;
 
   void updateFilter();
 };
@@ -11,7 +11,7 @@ class BufferDecoder : public AudioDecoder {
 public:
   BufferDecoder(SoundBuffer&& buffer_p);
   BufferDecoder(std::shared_ptr<const SoundBuffer> buffer_p);
-  bool get(std::span<sample_t> out) override;
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
   void seek(uint64_t position) override;
   uint64_t getLength() override;
   Frequency getSampleRate() override;
@@ -17,6 +17,7 @@ public:
   }
 
   void process(std::span<const sample_t> in, std::span<sample_t> out)override ;
+  void processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) override;
   void setParameter(size_t id, ParameterValue value) override {}
   void setSampleRate(Frequency sampleRate) override {}
   uint32_t getTailTime() const override;
@@ -7,6 +7,7 @@
 #include <ZAudio/AudioOutput.h>
 #include <ZAudio/AudioInput.h>
 #include <ZAudio/SampleRateConversion.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio::Tools {
 
@@ -44,6 +45,9 @@ public:
     assert(in.size() == buffer.size());
     std::copy(buffer.cbegin(), buffer.cend(), in.begin());
     bufferEmpty = true;
+    if(numberOfChannels) {
+      renderSignal.requestFrames(in.size() / numberOfChannels);
+    }
   }
 
   size_t getNumberOfChannels() const;
@@ -56,6 +60,7 @@ private:
   uint32_t numberOfChannels = 0;
   std::atomic_bool error{false};
   std::string errorDescription;  
+  ThreadTools::RenderSignal renderSignal;
   friend CallbackInput;
   friend CallbackOutput;
 };
@@ -98,7 +103,7 @@ private:
   
   size_t ind = 0;
   std::vector<sample_t> buffer;
-  std::vector<Tools::SampleRateConverter> sampleRateConverters;
+  Tools::Resampler resampler;
 };
 
 class CallbackOutput : public AudioOutput {
@@ -111,6 +116,7 @@ public:
   bool errorOccured() const override;
   bool ended() const override;
   FrameFormat getFormat() const override;
+  std::shared_ptr<ThreadTools::RenderSignal> getRenderSignal() override;
 
   // only move constructors
   CallbackOutput(const CallbackOutput& oth) = delete;
@@ -129,12 +135,13 @@ private:
 
   FrameFormat format;
   Frequency outSampleRate;
+  Frequency sampleRate;
   std::shared_ptr<CallbackData> callbackData;    
   bool blocking = false;
 
   size_t ind = 0;
   std::vector<sample_t> buffer;
-  std::vector<Tools::SampleRateConverter> sampleRateConverters;
+  Tools::Resampler resampler;
 };
 
 
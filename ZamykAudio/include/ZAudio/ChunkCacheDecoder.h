@@ -0,0 +1,72 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <mutex>
+
+#include <ZAudio/AudioDecoder.h>
+#include <ZAudio/CommonTypes.h>
+
+namespace ZAudio {
+
+
+// decoded chunks of sounds shared by ChunkCacheDecoders, so sound played again doesn't need to be decoded again
+// it can be used by decoders from multiple threads
+class DecodedChunkCache {
+public:
+  static constexpr size_t ChunkLength = 8192; // frames
+
+  explicit DecodedChunkCache(size_t maxChunks_p);
+
+  // nullptr if chunk is not in cache
+  std::shared_ptr<const std::vector<sample_t>> get(uint32_t sound, uint64_t chunk);
+  // least recently used chunk is removed if cache is full
+  void put(uint32_t sound, uint64_t chunk, std::shared_ptr<const std::vector<sample_t>> samples);
+  size_t size();
+
+private:
+  using Key = std::pair<uint32_t, uint64_t>;
+struct Entry {
+  Key key;
+  std::shared_ptr<const std::vector<sample_t>> samples;
+};
+  std::mutex mutex;
+  size_t maxChunks = 0;
+  std::list<Entry> entries; // most recently used first
+  std::map<Key, std::list<Entry>::iterator> index;
+};
+
+// reads decoder by chunks through DecodedChunkCache, sound identifies decoded sound in cache
+class ChunkCacheDecoder : public AudioDecoder {
+public:
+  ChunkCacheDecoder(std::unique_ptr<AudioDecoder> decoder_p, uint32_t sound_p, std::shared_ptr<DecodedChunkCache> cache_p);
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
+  void seek(uint64_t position) override;
+  uint64_t getLength() override;
+  Frequency getSampleRate() override;
+  uint64_t getPosition() override;
+  uint64_t getLoopStart() override;
+  uint64_t getLoopEnd() override;
+  void setLooped(bool looped_p) override;
+  bool errorOccured() const override;
+  FrameFormat getFormat() const override;
+private:
+  std::unique_ptr<AudioDecoder> decoder;
+  uint32_t sound = 0;
+  std::shared_ptr<DecodedChunkCache> cache;
+  size_t numberOfChannels = 0;
+  uint64_t length = 0;
+  uint64_t loopStart = 0;
+  uint64_t loopEnd = 0;
+  bool looped = false;
+  bool error = false;
+
+  uint64_t position = 0;
+  std::shared_ptr<const std::vector<sample_t>> chunk;
+  uint64_t chunkIndex = 0;
+
+  void loadChunk(uint64_t index);
+};
+
+
+} // namespace ZAudio
@@ -12,7 +12,11 @@
 namespace ZAudio {
 
 
+#ifdef ZAUDIO_FLOAT_SAMPLES
+using sample_t = float;
+#else
 using sample_t = double;
+#endif
 
 class Result {
 public:
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <ZAudio/CommonTypes.h>
+#include <ZAudio/Effect.h>
+#include <ZAudio/FIR_Filter.h>
+#include <ZAudio/SoundBuffer.h>
+#include <ZAudio/SoundCache.h>
+
+namespace ZAudio::Tools {
+
+
+// convolves every input with its own long impulse response without latency
+// beginning of impulse is processed by FIR_Filter, rest is split to big partitions that are processed by background thread one partition ahead
+// background part needs fft, without it whole impulse is processed by FIR_Filter
+class BackgroundConvolution {
+public:
+  static constexpr size_t TailPartitionSize = 4096;
+
+  explicit BackgroundConvolution(const std::vector<std::vector<double>>& impulses);
+  ~BackgroundConvolution();
+
+  BackgroundConvolution(const BackgroundConvolution& oth) = delete;
+  BackgroundConvolution& operator= (const BackgroundConvolution& oth) = delete;
+
+  // in[i] is convolved with impulses[i] and result is written to out[i]
+  void process(std::span<const sample_t> in, std::span<sample_t> out);
+  // block version, in[i] is convolved to out[i], all spans have the same length, in and out must not overlap
+  void process(std::span<const std::span<const sample_t>> in, std::span<const std::span<sample_t>> out);
+  size_t getNumberOfConvolutions() const;
+  // in real time partition boundary doesn't wait for late thread, tail of next partition is silent instead (underrun)
+  void setRealTime(bool realTime_p);
+  size_t getUnderruns() const;
+
+private:
+  std::vector<FIR_Filter> heads;
+  std::vector<PartitionedConvolution> tails;
+  std::vector<std::vector<sample_t>> tailInputs;
+  std::vector<std::vector<sample_t>> tailOutputs;
+  size_t position = 0;
+  bool realTime = false;
+  bool discardThreadOutput = false; // output thread computed during underrun is too late to be used
+  size_t skippedPartitions = 0;     // input partitions lost in underruns, thread processes silence instead of them
+  size_t underruns = 0;
+
+  // buffers owned by thread while it's busy, busy hands them over between threads (release/acquire)
+  std::vector<std::vector<sample_t>> threadInputs;
+  std::vector<std::vector<sample_t>> threadOutputs;
+  size_t threadSkippedPartitions = 0;
+  std::vector<sample_t> silence;
+  std::atomic_bool busy{false};
+  std::atomic_bool stop{false};
+  std::thread thread;
+
+  void exchangeWithThread();
+  void threadFunction();
+};
+
+
+} // namespace ZAudio::Tools
+
+namespace ZAudio {
+
+
+// mono effect convolves with first channel of impulse
+// stereo effect is true stereo: impulse holds left input to left and right output, rightImpulse holds right input to left and right output
+// if rightImpulse is not set, impulse is used mirrored
+class ConvolutionReverbEffect : public Effect {
+public:
+struct Parameters {
+  std::string impulsePath;
+  std::string rightImpulsePath;
+  FrameFormat format = FrameFormat::Mono;
+  Volume wet = Volume::dB(-6);
+  Volume dry = Volume::dB(0);
+
+  Parameters() = default;
+  Parameters(const std::string& impulsePath_p, FrameFormat format_p, Volume wet_p, Volume dry_p, const std::string& rightImpulsePath_p = "");
+};
+  static constexpr uint32_t NumOfParameters = 2;
+  // without fft whole impulse is processed in direct form, so longer impulses are refused (and truncated after resampling)
+  static constexpr size_t MaxImpulseLengthWithoutFFT = 2048;
+  enum : uint32_t {
+    WetID,
+    DryID,
+    GetUnderrunsID // output value, number of partitions whose tail was silent because background thread was late
+  };
+
+  explicit ConvolutionReverbEffect(Parameters parameters_p);
+
+  // loads impulses from paths in parameters, they are resampled to sample rate of effect in setSampleRate
+  Result loadImpulses(SoundCache& cache);
+  Result setImpulses(std::shared_ptr<const SoundBuffer> impulse_p, std::shared_ptr<const SoundBuffer> rightImpulse_p = nullptr);
+
+  FrameFormat getOutputFormat() const override;
+  FrameFormat getInputFormat() const override;
+
+  void process(std::span<const sample_t> in, std::span<sample_t> out) override;
+  void processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) override;
+  void setParameter(size_t id, ParameterValue value) override;
+  void setSampleRate(Frequency sampleRate_p) override;
+  void setRealTime(bool realTime_p) override;
+  ParameterValue getOutputValue(size_t id) override;
+  uint32_t getTailTime() const override;
+
+  std::unique_ptr<Effect> clone() const override;
+  Result save(Tools::TreeDatabaseWriter writer) const override;
+  Result load(Tools::TreeDatabaseReader reader) override;
+  std::string getID() const override;
+  int64_t getVersion() const override;
+  Parameters getParameters() const;
+private:
+  Parameters parameters;
+  Frequency sampleRate;
+  bool realTime = false;
+  std::shared_ptr<const SoundBuffer> impulse;
+  std::shared_ptr<const SoundBuffer> rightImpulse;
+  std::unique_ptr<Tools::BackgroundConvolution> convolution;
+  uint32_t tailTime = 0;
+  std::vector<sample_t> wetBlock; // output of every convolution in processBlock
+
+  void prepareConvolution();
+};
+
+
+} // namespace ZAudio
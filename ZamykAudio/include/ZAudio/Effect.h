@@ -3,6 +3,7 @@
 #include <string>
 #include <span>
 
+#include <ZAudio/AudioBlock.h>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/FrameFormat.h>
 #include <ZAudio/TreeDatabase.h>
@@ -17,10 +18,26 @@ public:
   virtual FrameFormat getOutputFormat() const = 0;
   virtual FrameFormat getInputFormat() const = 0;
   virtual void process(std::span<const sample_t> in, std::span<sample_t> out) = 0;    
+
+  // in and out may point to the same memory, effects overriding this must handle it
+  virtual void processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+    std::array<sample_t, Tools::MaxNumberOfChannels> frame1;
+    std::array<sample_t, Tools::MaxNumberOfChannels> frame2;
+    std::fill(frame1.begin(), frame1.end(), 0.);
+    std::fill(frame2.begin(), frame2.end(), 0.);
+    for(size_t i = 0; i < frames; i++) {
+      in.getFrame(i, frame1);
+      process(frame1, frame2);
+      out.setFrame(i, frame2);
+    }
+  }
+
   virtual void setParameter(size_t id, ParameterValue value) = 0;
   virtual void setParameter(size_t id1, size_t id2, ParameterValue value) {}
   virtual ParameterValue getOutputValue(size_t id) { return ParameterValue(); }  
   virtual void setSampleRate(Frequency sampleRate) = 0;
+  // engine tells if effect runs in real time, effects with background work must not wait for it then (default is offline)
+  virtual void setRealTime(bool realTime) {}
   
   virtual std::unique_ptr<Effect> clone() const = 0;
   virtual Result save(Tools::TreeDatabaseWriter writer) const = 0;
@@ -50,27 +67,29 @@ static ResultValue<std::unique_ptr<Effect>> loadEffectFromXML(In& inStream) {
 }
 
 inline SoundBuffer processBuffer(Effect& effect, const SoundBuffer& input) {  
+  constexpr size_t BlockSize = 256;
   effect.setSampleRate(input.getSampleRate());
   SoundBuffer output(input.getSampleRate(), effect.getOutputFormat(), input.getLength() + effect.getTailTime());
 
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame1;
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame2;
-  std::fill(frame1.begin(), frame1.end(), 0.);
-  std::fill(frame2.begin(), frame2.end(), 0.);
-
-  for(size_t i = 0; i < output.getLength(); i++) {
-    if(i < input.getLength()) {
-     input.getFrame(i, frame1.begin());
-    }
-    else {
-      std::fill(frame1.begin(), frame1.end(), 0.);
+  AudioBlock inputBlock(BlockSize);
+  AudioBlock effectInputBlock(BlockSize);
+
+  for(size_t start = 0; start < output.getLength(); start += BlockSize) {
+    const size_t frames = std::min(BlockSize, output.getLength() - start);
+    auto inputView = inputBlock.getView(input.getFrameFormat(), frames);
+    inputView.clear();
+    if(start < input.getLength()) {
+      const size_t available = std::min(frames, input.getLength() - start);
+      for(size_t channel = 0; channel < input.getNumberOfChannels(); channel++) {
+        std::copy_n(input.getChannel(channel).begin() + start, available, inputView.getChannel(channel).begin());
+      }
     }
 
-    Tools::convertFrames(frame1, input.getFrameFormat(), frame2, effect.getInputFormat());    
-
-    effect.process(frame2, frame1);
+    auto effectInputView = effectInputBlock.getView(effect.getInputFormat(), frames);
+    Tools::convertBlock(inputView, input.getFrameFormat(), effectInputView, effect.getInputFormat(), frames);
 
-    output.setFrame(i, frame1.begin());
+    auto outputView = output.getView(start, frames);
+    effect.processBlock(effectInputView, outputView, frames);
   }
 
   return output;
@@ -3,6 +3,7 @@
 #include <ZAudio/AutoWahEffect.h>
 #include <ZAudio/BitCrusherEffect.h>
 #include <ZAudio/BypassEffect.h>
+#include <ZAudio/ConvolutionReverbEffect.h>
 #include <ZAudio/DelayEffect.h>
 #include <ZAudio/DuckDelayEffect.h>
 #include <ZAudio/DynamicsProcessorEffect.h>
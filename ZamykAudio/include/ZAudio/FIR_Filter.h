@@ -1,22 +1,80 @@
 #pragma once
 
+#include <complex>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/WindowFunction.h>
-#include <ZAudio/CircularBuffer.h>
+#include <ZAudio/FFT.h>
 
 namespace ZAudio::Tools {
 
 
+// uniformly partitioned overlap-save convolution, computes contribution of all partitions except the first one
+// first partition has to be handled by caller (FIR_Filter does it in direct form), so there is no added latency
+class PartitionedConvolution {
+public:
+  PartitionedConvolution() = default;
+  PartitionedConvolution(std::span<const double> coefficients, size_t partitionSize_p);
+
+  PartitionedConvolution(const PartitionedConvolution& oth);
+  PartitionedConvolution(PartitionedConvolution&& oth) noexcept = default;
+  PartitionedConvolution& operator= (const PartitionedConvolution& oth);
+  PartitionedConvolution& operator= (PartitionedConvolution&& oth) noexcept = default;
+
+  sample_t process(sample_t in) {
+    const sample_t out = output[position];
+    window[partitionSize + position] = in;
+    if(++position == partitionSize) {
+      processWindow(output);
+      position = 0;
+    }
+    return out;
+  }
+
+  // block version, in is next partition of input and out receives output of the partition after it
+  void processPartition(std::span<const sample_t> in, std::span<sample_t> out);
+  size_t getPartitionSize() const;
+
+private:
+  size_t partitionSize = 0;
+  std::vector<std::vector<std::complex<double>>> partitions;    // spectra of impulse partitions, only first half of bins
+  std::vector<std::vector<std::complex<double>>> inputSpectra;  // frequency domain delay line
+  size_t newestSpectrum = 0;
+  std::vector<std::complex<double>> accumulator;
+  std::vector<sample_t> window;  // previous and current input partition
+  std::vector<sample_t> output;
+  size_t position = 0;
+  std::unique_ptr<FFT> fft;
+
+  void processWindow(std::span<sample_t> out);
+};
+
 class FIR_Filter {
 public:
+  // filters longer than this use PartitionedConvolution when fft is enabled
+  static constexpr size_t FFTThreshold = 256;
+  static constexpr size_t PartitionSize = 128;
+
   FIR_Filter() = default;
   explicit FIR_Filter(const std::vector<double>& coefficients_p);
   static FIR_Filter sincFilter(Frequency sampleRate, Frequency cutOffFrequency, uint32_t windowSize, WindowFunction::Type windowFunctionType);
   sample_t process(sample_t in);
+  void process(std::span<const sample_t> in, std::span<sample_t> out); // in and out may be the same span
+  bool usesFFT() const;
+
 private:
   std::vector<double> coefficients;
-  CircularBuffer<sample_t> buffer;
+  size_t directLength = 0;        // coefficients processed in direct form
+  std::vector<sample_t> history;  // last directLength inputs stored twice, so they can be read without wrapping
+  size_t historyPosition = 0;
+  std::optional<PartitionedConvolution> convolution;
+
+  void prepare();
 };
 
 
-} // namespace ZAudio::Tools
\ No newline at end of file
+} // namespace ZAudio::Tools
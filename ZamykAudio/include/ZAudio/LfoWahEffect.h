@@ -52,6 +52,7 @@ private:
   Frequency currFrequency;
   Tools::LowFrequencyOscillator lfo;
   Tools::AnalogFilter bandPass;  
+  size_t controlCounter = 0;
 
   void updateFilter();
 };
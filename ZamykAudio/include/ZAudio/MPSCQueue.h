@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace ZAudio::Tools {
+
+
+// bounded lock-free queue for many writers and one reader
+// every slot has its own sequence number, so writers only compete for write position, slot of writer that is in the middle of push looks empty to reader
+template<typename T>
+class MPSCQueue {
+public:
+  // size is rounded up to power of 2, at least 2 (with one slot, slot of the next round would look free)
+  explicit MPSCQueue(size_t size) :
+    mask(std::bit_ceil(std::max<size_t>(size, 2)) - 1),
+    slots(std::make_unique<Slot[]>(mask + 1))
+  {
+    assert(size > 0);
+    for(size_t i = 0; i <= mask; i++) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator = (const MPSCQueue&) = delete;
+
+  // v is moved only if it was pushed
+  template<typename T2>
+  bool tryPush(T2&& v) {
+    size_t position = writePosition.load(std::memory_order_relaxed);
+    while(true) {
+      Slot& slot = slots[position & mask];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+      if(diff == 0) {
+        if(writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          slot.value = std::forward<T2>(v);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(diff < 0) {
+        // reader didn't pop value from the previous round yet
+        return false;
+      }
+      else {
+        position = writePosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template<typename T2>
+  void waitAndPush(T2&& v) {
+    while(!tryPush(std::forward<T2>(v))) {
+      std::this_thread::yield();
+    }
+  }
+
+  // only one thread can pop
+  std::optional<T> tryPop() {
+    Slot& slot = slots[readPosition & mask];
+    if(slot.sequence.load(std::memory_order_acquire) != readPosition + 1) {
+      return std::nullopt;
+    }
+    T ans = std::move(slot.value);
+    slot.sequence.store(readPosition + mask + 1, std::memory_order_release);
+    readPosition++;
+    return ans;
+  }
+
+  T waitAndPop() {
+    while(true) {
+      if(auto ans = tryPop()) {
+        return std::move(*ans);
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  size_t getCapacity() const {
+    return mask + 1;
+  }
+
+private:
+struct Slot {
+  std::atomic<size_t> sequence{0};
+  T value;
+};
+  const size_t mask;
+  std::unique_ptr<Slot[]> slots;
+  // writers and reader are on different cache lines, so they don't slow each other down
+  alignas(64) std::atomic<size_t> writePosition{0};
+  alignas(64) size_t readPosition = 0;
+};
+
+
+} // namespace ZAudio::Tools
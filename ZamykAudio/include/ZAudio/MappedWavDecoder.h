@@ -0,0 +1,79 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include <ZAudio/AudioDecoder.h>
+#include <ZAudio/CommonTypes.h>
+
+namespace ZAudio {
+
+
+// read only memory mapping of whole file
+class MappedFile {
+public:
+enum struct Advice {
+  Sequential, WillNeed
+};
+  static ResultValue<std::shared_ptr<const MappedFile>> open(const std::filesystem::path& path);
+  MappedFile(const std::filesystem::path& path, Result& result);
+  ~MappedFile();
+
+  MappedFile(const MappedFile& oth) = delete;
+  MappedFile& operator= (const MappedFile& oth) = delete;
+
+  std::span<const uint8_t> getData() const;
+  // hint for OS how bytes in range will be used, it does nothing where it's not supported
+  void advise(size_t offset, size_t length, Advice advice) const;
+
+private:
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+#ifdef _WIN32
+  void* file = nullptr;
+  void* mapping = nullptr;
+#endif
+};
+
+// reads uncompressed wav (8, 16, 24, 32 bit integer or 32, 64 bit float) straight from memory mapped file
+// samples are converted when they are read, so file isn't decoded to memory before playing and OS page cache keeps the parts in use
+class MappedWavDecoder : public AudioDecoder {
+public:
+  // how much is read ahead after seek, and at the start
+  static constexpr double ReadAheadSeconds = 1.;
+
+  static ResultValue<std::unique_ptr<AudioDecoder>> load(const std::filesystem::path& path);
+  MappedWavDecoder(std::shared_ptr<const MappedFile> file_p, Result& result);
+
+  size_t read(std::span<sample_t> interleaved, size_t frames) override;
+  void seek(uint64_t position_p) override;
+  void setLooped(bool looped_p) override;
+
+  uint64_t getLength() override;
+  Frequency getSampleRate() override;
+  uint64_t getPosition() override;
+  bool errorOccured() const override;
+  FrameFormat getFormat() const override;
+
+private:
+enum struct Encoding {
+  UInt8, Int16, Int24, Int32, Float32, Float64
+};
+  std::shared_ptr<const MappedFile> file;
+  std::span<const uint8_t> samples; // data chunk
+  Encoding encoding = Encoding::Int16;
+  size_t bytesPerSample = 0;
+  size_t numberOfChannels = 0;
+  FrameFormat format = FrameFormat::None;
+  Frequency sampleRate;
+  uint64_t length = 0;
+  uint64_t position = 0;
+  bool looped = false;
+
+  Result parseHeader();
+  void readAhead();
+};
+
+
+} // namespace ZAudio
@@ -20,6 +20,7 @@ public:
   void setParameter(size_t id1, size_t id2, ParameterValue value) override;
   ParameterValue getOutputValue(size_t id) override;
   void setSampleRate(Frequency sampleRate) override;
+  void setRealTime(bool realTime) override;
   std::unique_ptr<Effect> clone() const override;
   Result save(Tools::TreeDatabaseWriter writer) const override;
   Result load(Tools::TreeDatabaseReader reader) override;
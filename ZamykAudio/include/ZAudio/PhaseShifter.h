@@ -24,7 +24,10 @@ private:
   static constexpr size_t NumOfFilters = 6;
   std::array<Frequency, NumOfFilters> minFrequencies = {Frequency::Hz(16), Frequency::Hz(33), Frequency::Hz(48), Frequency::Hz(98), Frequency::Hz(160), Frequency::Hz(260)};
   std::array<Frequency, NumOfFilters> maxFrequencies = {Frequency::Hz(1600), Frequency::Hz(3300), Frequency::Hz(4800), Frequency::Hz(9800), Frequency::Hz(16000), Frequency::Hz(20480)};
-  std::array<AnalogFilter, NumOfFilters> filters;  
+  AnalogFilterBank<NumOfFilters> filters;  
+  size_t controlCounter = 0;
+
+  void updateFilters(size_t frames);
 };
 
 
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <optional>
+#include <span>
 #include <thread>
+#include <vector>
 
 namespace ZAudio::Tools {
 
@@ -56,6 +61,45 @@ public:
     return ans;
   }
 
+  // bulk versions move as many values as they can and return their number
+  // writer pushes values only after all of them are written, so reader doesn't see part of them
+  size_t tryPushMany(std::span<const T> values) {
+    const uint32_t write = writeIndex;
+    const size_t n = std::min(values.size(), getFreeSpace());
+    const size_t first = std::min(n, buffer.size() - write);
+    std::copy_n(values.begin(), first, buffer.begin() + write);
+    std::copy_n(values.begin() + first, n - first, buffer.begin());
+    writeIndex = (write + n) % buffer.size();
+    return n;
+  }
+
+  size_t tryPopMany(std::span<T> out) {
+    const uint32_t read = readIndex;
+    const size_t n = std::min(out.size(), getReadable());
+    const size_t first = std::min(n, buffer.size() - read);
+    std::move(buffer.begin() + read, buffer.begin() + read + first, out.begin());
+    std::move(buffer.begin(), buffer.begin() + (n - first), out.begin() + first);
+    readIndex = (read + n) % buffer.size();
+    return n;
+  }
+
+  // reader can drop values without reading them
+  size_t discard(size_t count) {
+    const size_t n = std::min(count, getReadable());
+    readIndex = (readIndex + n) % buffer.size();
+    return n;
+  }
+
+  // exact for reader, writer can only push more values in the meantime
+  size_t getReadable() const {
+    return (writeIndex + buffer.size() - readIndex) % buffer.size();
+  }
+
+  // exact for writer, reader can only pop more values in the meantime
+  size_t getFreeSpace() const {
+    return buffer.size() - 1 - getReadable();
+  }
+
 private:
   std::vector<T> buffer;
   std::atomic_uint32_t writeIndex = 0;
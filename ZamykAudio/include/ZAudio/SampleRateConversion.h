@@ -1,24 +1,35 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <span>
+#include <vector>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/CircularBuffer.h>
 #include <ZAudio/FIR_Filter.h>
 #include <ZAudio/SoundBuffer.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio::Tools {
 
 namespace SampleRateConversion {
 constexpr int32_t DefaultFilterRadius = 50;
+// number of output samples of one channel converted by one task
+constexpr size_t ChunkLength = 1 << 16;
+// gets finished part of conversion from 0 to 1, it's called from worker threads, but never at the same time
+using ProgressFunction = std::function<void(double)>;
 }
 
 
 void convertSampleRateLinearInterpolation(std::span<const sample_t> in, std::span<sample_t> out, Frequency inSampleRate, Frequency outSampleRate);
 void convertSampleRateLinearInterpolation(std::span<const sample_t> in, std::span<sample_t> out, size_t inSize, size_t outSize);
 SoundBuffer convertSampleRateLinear(const SoundBuffer& in, Frequency outSampleRate);
-SoundBuffer convertSampleRateSinc(const SoundBuffer& in, Frequency outSampleRate, int32_t filterRadius = SampleRateConversion::DefaultFilterRadius, std::atomic_bool* interrupt = nullptr);
-SoundBuffer changeTempo(const SoundBuffer& in, double tempo, int32_t fitlerRadius = SampleRateConversion::DefaultFilterRadius, std::atomic_bool* interrupt = nullptr);
+// channels are split to chunks, that are converted on pool if it's not null
+SoundBuffer convertSampleRateSinc(const SoundBuffer& in, Frequency outSampleRate, int32_t filterRadius = SampleRateConversion::DefaultFilterRadius, std::atomic_bool* interrupt = nullptr,
+                                  ThreadTools::WorkerPool* pool = nullptr, const SampleRateConversion::ProgressFunction& progress = nullptr);
+SoundBuffer changeTempo(const SoundBuffer& in, double tempo, int32_t fitlerRadius = SampleRateConversion::DefaultFilterRadius, std::atomic_bool* interrupt = nullptr,
+                        ThreadTools::WorkerPool* pool = nullptr, const SampleRateConversion::ProgressFunction& progress = nullptr);
 
 
 class SincLookup {
@@ -26,6 +37,9 @@ public:
   SincLookup() = default;
   SincLookup(Frequency sampleRate, Frequency cutOffFrequency, uint32_t radius, uint32_t overSample_p, WindowFunction::Type windowFunctionType);
   double get(uint32_t index, double fract) const;
+  // coefficients for inputs from radius samples before to radius samples after position with fract phase / overSample, ready for dot product
+  std::vector<double> getKernel(uint32_t phase, uint32_t radius) const;
+  uint32_t getOverSample() const;
 private:
   uint32_t overSample = 1;
   std::vector<double> coefficients;
@@ -42,6 +56,70 @@ private:
   CircularBuffer<sample_t> buffer;
 };
 
+// multichannel online sample rate converter, frames are interleaved
+// ratios of whole sample rates (like 44.1k <-> 48k) use precomputed polyphase filter table, that is shared by all resamplers with the same ratio and filter length
+// other ratios and live changes of frequency use SincFilter
+class Resampler {
+public:
+  enum class Quality {
+    Fast,
+    Medium,
+    Best
+  };
+  // ratios needing more phases use SincFilter
+  static constexpr uint32_t MaxPhases = 1024;
+
+  static size_t getFilterLength(Quality quality);
+
+  Resampler() = default;
+  Resampler(size_t numberOfChannels_p, Frequency inSampleRate_p, Frequency outSampleRate_p, Quality quality = Quality::Medium);
+  Resampler(size_t numberOfChannels_p, Frequency inSampleRate_p, Frequency outSampleRate_p, size_t filterLength_p);
+
+  // for live manipulating of frequency, doesn't update filter to prevent audio pauses, sinc filter used after it is prepared in constructor
+  void setOutSampleRateNoFilterUpdate(Frequency outSampleRate_p);
+
+  void push(std::span<const sample_t> frame);
+  bool outReady() const;
+  void get(std::span<sample_t> frame);
+
+  // pushes all frames from in and writes converted frames to out, returns number of written frames
+  // out needs space for getMaxOutputFrames(number of frames in in)
+  size_t process(std::span<const sample_t> in, std::span<sample_t> out);
+  size_t getMaxOutputFrames(size_t inFrames) const;
+
+  size_t getNumberOfChannels() const;
+  bool usesPolyphase() const;
+
+private:
+  enum class Mode {
+    PassThrough,
+    Polyphase,
+    Sinc
+  };
+
+  size_t numberOfChannels = 0;
+  Frequency inSampleRate;
+  Frequency outSampleRate;
+  size_t filterLength = 0;
+  Mode mode = Mode::PassThrough;
+
+  // last filterLength inputs of each channel stored twice, so they can be read without wrapping, used by PassThrough and Polyphase
+  std::vector<sample_t> history;
+  size_t historyPosition = 0;
+
+  std::shared_ptr<const std::vector<double>> phaseTable;
+  uint32_t phases = 1;
+  uint32_t decimation = 1;
+  uint32_t phase = 1;
+
+  std::vector<SincFilter> sincFilters;
+  double step = 1.;
+  double position = 1.;
+
+  void switchToSinc();
+};
+
+// single channel version of Resampler
 class SampleRateConverter {
 public:
   SampleRateConverter() = default;
@@ -58,15 +136,7 @@ public:
   sample_t get();
 
 private:
-  Frequency inSampleRate;
-  Frequency outSampleRate;
-
-  SincFilter filter;  
-  sample_t out = 0.;
-  bool diffrentSampleRates = false;
-
-  double step = 0.;
-  double position = 1.;
+  Resampler resampler;
 };
 
 
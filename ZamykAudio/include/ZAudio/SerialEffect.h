@@ -19,8 +19,10 @@ public:
   FrameFormat getOutputFormat() const override;
   FrameFormat getInputFormat() const override;
   void process(std::span<const sample_t> in, std::span<sample_t> out) override;
+  void processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) override;
   void setParameter(size_t id, ParameterValue value) override;
   void setSampleRate(Frequency sampleRate_p) override;
+  void setRealTime(bool realTime_p) override;
   void setParameter(size_t effectID, size_t id, ParameterValue value) override;
   uint32_t getTailTime() const override;
   std::unique_ptr<Effect> clone() const override;
@@ -33,8 +35,13 @@ public:
 private:  
   bool sampleRateSet = false;
   Frequency sampleRate;
+  bool realTime = false;
   std::vector<std::unique_ptr<Effect>> effects;
   std::vector<bool> bypass;
+
+  AudioBlock block1;
+  AudioBlock block2;
+  AudioBlock tmpBlock;
 };
 
 
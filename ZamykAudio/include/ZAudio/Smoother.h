@@ -95,6 +95,10 @@ public:
     return changed;
   }
 
+  bool hasEnded() const {
+    return ended;
+  }
+
 private:
   double curr = 0.;
   double to = 0.;
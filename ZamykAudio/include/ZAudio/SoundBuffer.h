@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ZAudio/AudioBlock.h>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/FrameFormat.h>
 #include <ZAudio/TwoDimVector.h>
@@ -43,6 +44,8 @@ public:
     return samples.getRow(channel);
   }
 
+  AudioBlockView getView(size_t offset, size_t length);
+
 private:
   FrameFormat frameFormat = FrameFormat::None;
   Frequency sampleRate;
@@ -6,6 +6,8 @@
 #include <ZAudio/SoundBuffer.h>
 #include <ZAudio/AudioInput.h>
 #include <ZAudio/AudioDecoder.h>
+#include <ZAudio/ChunkCacheDecoder.h>
+#include <ZAudio/ThreadTools.h>
 
 namespace ZAudio {
 
@@ -38,19 +40,80 @@ namespace ZAudio {
 class SoundCache {
 public:
 using LoadingFunction = std::function<ResultValue<std::unique_ptr<AudioDecoder>>(const std::filesystem::path&)>;
+// creates decoder reading encoded file from memory
+using MemoryLoadingFunction = std::function<ResultValue<std::unique_ptr<AudioDecoder>>(std::shared_ptr<const std::vector<uint8_t>>)>;
 enum struct OpenMode {
-  Stream, PreBuffer
+  Stream, PreBuffer, Compressed
+};
+static constexpr size_t DefaultDecodedChunks = 32;
+struct Statistics {
+  uint64_t hits = 0;      // PreBuffer sound was in memory
+  uint64_t misses = 0;    // PreBuffer sound had to be loaded again or converted
+  uint64_t evictions = 0;
+  size_t memoryUsage = 0; // bytes of samples of PreBuffer sounds, only these count toward memory budget
+  size_t compressedMemoryUsage = 0; // bytes of files of Compressed sounds, they are kept until removed
 };
   void addLoadingFunction(const std::string& extension, LoadingFunction loadingFunction);
+  // needed for Compressed sounds
+  void addMemoryLoadingFunction(const std::string& extension, MemoryLoadingFunction loadingFunction);
+struct BatchResult {
+  std::optional<CacheSoundID> id; // std::nullopt if sound couldn't be added
+  std::string error;
+};
+// gets index of path and its result, it's called from worker threads, but never at the same time
+using BatchCallback = std::function<void(size_t, const BatchResult&)>;
   std::optional<CacheSoundID> add(const std::filesystem::path& path, OpenMode openMode = SoundCache::OpenMode::PreBuffer);
+  // sounds are decoded (and converted to target sample rate) on pool if it's not null, so number of threads of pool + 1 files is decoded at once
+  // returns after all sounds are added, results are in order of paths
+  std::vector<BatchResult> addBatch(const std::vector<std::filesystem::path>& paths, OpenMode openMode = SoundCache::OpenMode::PreBuffer,
+                                    ThreadTools::WorkerPool* pool = nullptr, const BatchCallback& callback = nullptr);
+  void remove(CacheSoundID id);
   std::unique_ptr<FileInput> getSound(CacheSoundID id, bool playing = true, bool looped = false, Time position = Time::seconds(0));
+  std::shared_ptr<const SoundBuffer> getBuffer(CacheSoundID id); // only for PreBuffer sounds, nullptr otherwise
+  // copy of PreBuffer sound in sampleRate, converted only on first call, nullptr for Stream sounds
+  std::shared_ptr<const SoundBuffer> getBuffer(CacheSoundID id, Frequency sampleRate);
+  // PreBuffer sounds are played from copies converted to this sample rate (sample rate of engine), so FileInput doesn't resample them
+  void setTargetSampleRate(std::optional<Frequency> sampleRate);
+  // least recently used PreBuffer sounds, whose samples are not used by anyone else, are evicted to fit in budget and loaded again when needed
+  // Compressed sounds are not evictable (their file may be gone), so they don't count toward budget
+  void setMemoryBudget(std::optional<size_t> bytes);
+  // decoded chunks of Compressed sounds shared by their FileInputs, change affects only FileInputs created later
+  void setDecodedChunkCacheSize(size_t chunks);
+  Statistics getStatistics() const;
   std::string getError() const;
 private:
+struct PreBufferedSound {
+  std::filesystem::path path;
+  std::shared_ptr<SoundBuffer> buffer; // nullptr after eviction or once converted copy exists, loaded again from path when needed
+  std::vector<std::shared_ptr<SoundBuffer>> converted; // at most one for every sample rate
+  uint64_t lastUse = 0;
+};
+struct CompressedSound {
+  std::string extension;
+  std::shared_ptr<const std::vector<uint8_t>> data;
+};
   std::unordered_map<std::string, LoadingFunction> loadingFunctions;
-  std::unordered_map<CacheSoundID, std::shared_ptr<SoundBuffer>> preBufferedSounds;
+  std::unordered_map<std::string, MemoryLoadingFunction> memoryLoadingFunctions;
+  std::unordered_map<CacheSoundID, PreBufferedSound> preBufferedSounds;
   std::unordered_map<CacheSoundID, std::filesystem::path> streamSounds;
+  std::unordered_map<CacheSoundID, CompressedSound> compressedSounds;
+  std::shared_ptr<DecodedChunkCache> chunkCache = std::make_shared<DecodedChunkCache>(DefaultDecodedChunks);
+  std::optional<Frequency> targetSampleRate;
+  std::optional<size_t> memoryBudget;
+  Statistics statistics;
+  uint64_t useCounter = 0;
   uint32_t lastID = 0;
   std::string error;
+
+  // decoding doesn't change cache, so it can be done from multiple threads
+  ResultValue<std::shared_ptr<SoundBuffer>> decode(const std::filesystem::path& path) const;
+  ResultValue<PreBufferedSound> decodePreBuffered(const std::filesystem::path& path) const;
+  void insertPreBuffered(CacheSoundID id, PreBufferedSound sound);
+  ResultValue<CompressedSound> readCompressed(const std::filesystem::path& path) const;
+  bool hasLoadingFunction(const std::filesystem::path& path, OpenMode openMode) const;
+  // nullopt sampleRate means original sample rate
+  std::shared_ptr<const SoundBuffer> getPreBuffered(CacheSoundID id, std::optional<Frequency> sampleRate);
+  void evict(std::optional<CacheSoundID> keep = std::nullopt);
 };
 
 
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <cstdint>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 
 namespace ZAudio::ThreadTools {
@@ -9,5 +17,181 @@ namespace ZAudio::ThreadTools {
 void setHighPriority(std::thread& thread);
 
 
-} // namespace ZAudio::ThreadTools
+// fixed set of high priority threads, used to split work of one thread (for example engine thread) into independent tasks
+class WorkerPool {
+public:
+  explicit WorkerPool(size_t numberOfThreads);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator = (const WorkerPool&) = delete;
+
+  // calls function(i) for every i in [0, count), calling thread also takes tasks, returns when all tasks are finished
+  template<typename F>
+  void parallelFor(size_t count, F&& function) {
+    if(threads.empty() || count <= 1) {
+      for(size_t i = 0; i < count; i++) {
+        function(i);
+      }
+      return;
+    }
+    auto task = [](void* context, size_t i) {
+      (*static_cast<std::remove_reference_t<F>*>(context))(i);
+    };
+    run(count, task, &function);
+  }
+
+  size_t getNumberOfThreads() const;
+
+private:
+  using Task = void (*)(void*, size_t);
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable startCondition;
+  std::condition_variable finishCondition;
+
+  Task task = nullptr;
+  void* context = nullptr;
+  size_t count = 0;
+  size_t next = 0;
+  size_t finished = 0;
+  uint64_t generation = 0;
+  bool stop = false;
+
+  void run(size_t count_p, Task task_p, void* context_p);
+  void takeTasks(std::unique_lock<std::mutex>& lock);
+  void workerThread();
+};
+
+
+// shared threads that fill and drain buffers of streams (AsyncDecoder, AsyncEncoder), so streams don't need own threads
+// requested streams are served by urgency, the one with least buffered time goes first
+class IOExecutor {
+public:
+  static constexpr size_t DefaultNumberOfThreads = 2;
+
+  class Stream {
+  public:
+    virtual ~Stream() = default;
+    // how long stream can last without being served
+    virtual double getBufferedSeconds() const = 0;
+    // does part of stream work, returns true if it has more to do
+    virtual bool service() = 0;
+  private:
+    friend class IOExecutor;
+    std::atomic_bool queued{false};
+    std::atomic_bool wanted{false};
+    bool serving = false;
+  };
+
+  explicit IOExecutor(size_t numberOfThreads);
+  ~IOExecutor();
+
+  IOExecutor(const IOExecutor&) = delete;
+  IOExecutor& operator = (const IOExecutor&) = delete;
+
+  // used by streams created without executor
+  static IOExecutor& getShared();
+
+  // doesn't wait (can be called from audio thread), when executor is busy stream has to request again later
+  void request(Stream& stream);
+  // waits until stream is not served, it won't be served after that
+  void remove(Stream& stream);
+
+  void setNumberOfThreads(size_t numberOfThreads_p);
+  size_t getNumberOfThreads() const;
 
+private:
+  std::vector<std::thread> threads;
+  std::mutex resizeMutex;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::condition_variable servedCondition;
+  std::vector<Stream*> pending;
+  size_t numberOfThreads = 0;
+
+  void workerThread(size_t index);
+};
+
+
+// used by audio device callbacks to request frames from thread that renders them (engine thread), that can wait for requests without spinning
+class RenderSignal {
+public:
+  RenderSignal() = default;
+  RenderSignal(const RenderSignal&) = delete;
+  RenderSignal& operator = (const RenderSignal&) = delete;
+
+  void requestFrames(size_t frames); // can be called from any thread
+  void notify();                     // wakes waiting thread without requesting frames
+
+  // only one thread can wait, returns frames requested since last wait (multiplied by ratio), can return 0 after notify
+  size_t wait();
+  void setRatio(double ratio_p);     // for example sample rate of renderer / sample rate of device
+  void clear();
+
+private:
+  std::atomic<uint64_t> requested{0};
+  std::atomic<uint32_t> sequence{0};
+  uint32_t seenSequence = 0;
+  double ratio = 1.;
+  double remainder = 0.;
+};
+
+
+// value written by one thread and read by any number of threads without locks, reader copies it again if writer changed it in the meantime
+// words are atomic, so torn copy is only thrown away and never undefined behaviour
+template<typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable_v<T>);
+public:
+  SeqLock() {
+    store(T());
+  }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator = (const SeqLock&) = delete;
+
+  // only one thread can store
+  void store(const T& value) {
+    std::array<uint64_t, Words> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    const uint32_t s = sequence.load(std::memory_order_relaxed);
+    sequence.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(size_t i = 0; i < Words; i++) {
+      data[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence.store(s + 2, std::memory_order_release);
+  }
+
+  T load() const {
+    std::array<uint64_t, Words> words;
+    while(true) {
+      const uint32_t s = sequence.load(std::memory_order_acquire);
+      // odd sequence means writer is in the middle of store
+      if(s & 1) {
+        continue;
+      }
+      for(size_t i = 0; i < Words; i++) {
+        words[i] = data[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(sequence.load(std::memory_order_relaxed) == s) {
+        break;
+      }
+    }
+    // T can have default member initializers, it's still trivially copyable, so its bytes can be overwritten
+    T value;
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+private:
+  static constexpr size_t Words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  std::atomic<uint32_t> sequence{0};
+  std::array<std::atomic<uint64_t>, Words> data{};
+};
+
+
+} // namespace ZAudio::ThreadTools
@@ -55,10 +55,10 @@ struct Parameters {
   TubePreampClassA() = default;
 
   TubePreampClassA(Frequency sampleRate, Parameters parameters_p) : 
-    parameters(parameters_p),     
-    lowShelfFilter(AnalogFilter::Parameters::createLowShelfParameters(sampleRate, parameters.lowShelfFrequency, parameters.lowShelfGain)),
-    highShelfFilter(AnalogFilter::Parameters::createHighShelfParameters(sampleRate, parameters.highShelfFrequency, parameters.highShelfGain)) {
+    parameters(parameters_p) {
 
+      shelfFilters.reset(0, AnalogFilter::Parameters::createLowShelfParameters(sampleRate, parameters.lowShelfFrequency, parameters.lowShelfGain));
+      shelfFilters.reset(1, AnalogFilter::Parameters::createHighShelfParameters(sampleRate, parameters.highShelfFrequency, parameters.highShelfGain));
       std::fill(triodes.begin(), triodes.end(), TriodeClassA(sampleRate, getTriodeParameters()));
     }
 
@@ -68,8 +68,7 @@ struct Parameters {
       out = triodes[i].process(out);
     }
 
-    out = lowShelfFilter.process(out);
-    out = highShelfFilter.process(out);
+    out = shelfFilters.processCascade(out);
     
     for(size_t i = FilterPosition; i < triodes.size(); i++) {
       out = triodes[i].process(out);
@@ -81,8 +80,7 @@ struct Parameters {
 private:
   Parameters parameters;
   std::array<TriodeClassA, NumberOfTriodes> triodes;
-  AnalogFilter lowShelfFilter;
-  AnalogFilter highShelfFilter;
+  AnalogFilterBank<2> shelfFilters; // low shelf then high shelf
 
   TriodeClassA::Parameters getTriodeParameters() {
     TriodeClassA::Parameters ans;    
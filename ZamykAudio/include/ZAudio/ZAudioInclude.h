@@ -5,7 +5,9 @@
 #include <ZAudio/AudioEncoder.h>
 #include <ZAudio/BufferDecoder.h>
 #include <ZAudio/BufferEncoder.h>
+#include <ZAudio/ChunkCacheDecoder.h>
 #include <ZAudio/CommonTypes.h>
 #include <ZAudio/FrameFormat.h>
+#include <ZAudio/MappedWavDecoder.h>
 #include <ZAudio/SoundBuffer.h>
 #include <ZAudio/SoundCache.h>
@@ -5,6 +5,126 @@
 namespace ZAudio::Tools {
 
 
+namespace {
+
+void setAllPass(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency) {
+  const double tmpTan = tan(std::numbers::pi * frequency.Hz() / sampleRate.Hz());
+  const double alpha = ( tmpTan - 1 ) / ( tmpTan + 1 );
+  c.a0 = alpha;
+  c.a1 = 1.;
+  c.b1 = alpha;    
+}
+
+void setFirstOrderLowPass(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency) {
+  const double Nyquist = sampleRate.Hz();
+  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
+  const double gamma = cos(f) / (1 + sin(f));
+  c.a0 = (1 - gamma) / 2.;
+  c.a1 = c.a0;
+  c.b1 = -gamma;      
+}
+
+void setFirstOrderHighPass(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency) {
+  const double Nyquist = sampleRate.Hz();
+  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
+  const double gamma = cos(f) / (1 + sin(f));
+  c.a0 = (1 + gamma) / 2.;
+  c.a1 = -c.a0;
+  c.b1 = -gamma;    
+}
+
+void setLowPass(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency, double q) {
+  const double Nyquist = sampleRate.Hz();
+  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
+  const double d = 1. / q;
+  const double beta = 0.5 * (1. - (d / 2.) * sin(f)) / (1 + (d / 2.) * sin(f));
+  const double gamma = (0.5 + beta) * cos(f);
+  c.a0 = (0.5 + beta - gamma) / 2.;
+  c.a1 = 2. * c.a0;
+  c.a2 = c.a0;
+  c.b1 = -2. * gamma;
+  c.b2 = 2 * beta;  
+}
+
+void setHighPass(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency, double q) {
+  const double Nyquist = sampleRate.Hz();
+  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
+  const double d = 1. / q;
+  const double beta = 0.5 * (1. - (d / 2.) * sin(f)) / (1 + (d / 2.) * sin(f));
+  const double gamma = (0.5 + beta) * cos(f);
+  c.a0 = (0.5 + beta + gamma) / 2.;
+  c.a1 = -2. * c.a0;
+  c.a2 = c.a0;
+  c.b1 = -2. * gamma;
+  c.b2 = 2 * beta;
+}
+
+void setLowShelf(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency, Volume gain) {
+  const double K = tan(std::numbers::pi * frequency.Hz() / sampleRate.Hz());    
+  const double V = Volume::dB(std::fabs(gain.dB())).linear();    
+  if (gain.dB() >= 0) {    // boost
+    const double norm = 1 / (1 + sqrt(2) * K + K * K);
+    c.a0 = (1 + sqrt(2*V) * K + V * K * K) * norm;
+    c.a1 = 2 * (V * K * K - 1) * norm;
+    c.a2 = (1 - sqrt(2*V) * K + V * K * K) * norm;
+    c.b1 = 2 * (K * K - 1) * norm;
+    c.b2 = (1 - sqrt(2) * K + K * K) * norm;
+  }
+  else {    // cut
+    const double norm = 1 / (1 + sqrt(2*V) * K + V * K * K);
+    c.a0 = (1 + sqrt(2) * K + K * K) * norm;
+    c.a1 = 2 * (K * K - 1) * norm;
+    c.a2 = (1 - sqrt(2) * K + K * K) * norm;
+    c.b1 = 2 * (V * K * K - 1) * norm;
+    c.b2 = (1 - sqrt(2*V) * K + V * K * K) * norm;      
+  }
+}
+
+void setHighShelf(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency, Volume gain) {        
+  const double K = tan(std::numbers::pi * frequency.Hz() / sampleRate.Hz());    
+  const double V = Volume::dB(std::fabs(gain.dB())).linear();    
+  if (gain.dB() >= 0) {    // boost
+    const double norm = 1 / (1 + sqrt(2) * K + K * K);
+    c.a0 = (V + sqrt(2*V) * K + K * K) * norm;
+    c.a1 = 2 * (K * K - V) * norm;
+    c.a2 = (V - sqrt(2*V) * K + K * K) * norm;
+    c.b1 = 2 * (K * K - 1) * norm;
+    c.b2 = (1 - sqrt(2) * K + K * K) * norm;      
+  }
+  else {    // cut
+    const double norm = 1 / (V + sqrt(2*V) * K + K * K);
+    c.a0 = (1 + sqrt(2) * K + K * K) * norm;
+    c.a1 = 2 * (K * K - 1) * norm;
+    c.a2 = (1 - sqrt(2) * K + K * K) * norm;
+    c.b1 = 2 * (K * K - V) * norm;
+    c.b2 = (V - sqrt(2*V) * K + K * K) * norm;      
+  }    
+}
+
+void setBandPass(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency, double q) {
+  const double Nyquist = sampleRate.Hz();
+  const double k = tan( (std::numbers::pi * frequency.Hz() / Nyquist ) );
+  const double delta = k * k * q + k + q;
+  c.a0 = k / delta;
+  c.a1 = 0.;
+  c.a2 = -k / delta;
+  c.b1 = ( 2 * q * (k * k - 1) ) / delta;
+  c.b2 = ( k * k * q - k + q ) / delta;    
+}
+
+void setBandStop(AnalogFilter::Coefficients& c, Frequency sampleRate, Frequency frequency, double q) {
+  const double Nyquist = sampleRate.Hz();
+  const double k = tan( (std::numbers::pi * frequency.Hz() / Nyquist ) );
+  const double delta = k * k * q + k + q;
+  c.a0 = ( q * (k * k + 1) ) / delta;
+  c.a1 = ( 2 * q * (k * k - 1) ) / delta;
+  c.a2 = c.a0;
+  c.b1 = c.a1;
+  c.b2 = (k * k * q - k + q) / delta;    
+}
+
+} // namespace
+
 AnalogFilter::Parameters::Parameters(Type type_p, Frequency sampleRate_p, Frequency frequency_p, double q_p, Volume gain_p) :
   type(type_p),
   sampleRate(sampleRate_p),
@@ -53,188 +173,122 @@ AnalogFilter::Parameters AnalogFilter::Parameters::createBandStopParameters(Freq
 }
 
 
-AnalogFilter::AnalogFilter() : 
-  aDelay(2),
-  bDelay(2) {}
-
-AnalogFilter::AnalogFilter(Parameters parameters) : aDelay(2), bDelay(2) {
-  reset(parameters);
-}    
-
-void AnalogFilter::reset(Parameters parameters) {
-  setByPass();
+AnalogFilter::Coefficients AnalogFilter::Coefficients::create(const Parameters& parameters) {
+  Coefficients c;
   switch(parameters.type) {
     case Type::ByPass:        
     break;
 
     case Type::AllPass:
-      setAllPass(parameters.sampleRate, parameters.frequency);
+      setAllPass(c, parameters.sampleRate, parameters.frequency);
     break;
 
     case Type::LowPass:
-      setLowPass(parameters.sampleRate, parameters.frequency, parameters.q);
+      setLowPass(c, parameters.sampleRate, parameters.frequency, parameters.q);
      break;
 
     case Type::HighPass:
-      setHighPass(parameters.sampleRate, parameters.frequency, parameters.q);
+      setHighPass(c, parameters.sampleRate, parameters.frequency, parameters.q);
     break;
 
     case Type::FirstOrderLowPass:
-      setFirstOrderLowPass(parameters.sampleRate, parameters.frequency);
+      setFirstOrderLowPass(c, parameters.sampleRate, parameters.frequency);
      break;
 
     case Type::FirstOrderHighPass:
-      setFirstOrderHighPass(parameters.sampleRate, parameters.frequency);
+      setFirstOrderHighPass(c, parameters.sampleRate, parameters.frequency);
     break;
 
     case Type::LowShelf:
-      setLowShelf(parameters.sampleRate, parameters.frequency, parameters.gain);
+      setLowShelf(c, parameters.sampleRate, parameters.frequency, parameters.gain);
     break;
 
     case Type::HighShelf:
-      setHighShelf(parameters.sampleRate, parameters.frequency, parameters.gain);
+      setHighShelf(c, parameters.sampleRate, parameters.frequency, parameters.gain);
     break;
 
     case Type::BandPass:
-      setBandPass(parameters.sampleRate, parameters.frequency, parameters.q);
+      setBandPass(c, parameters.sampleRate, parameters.frequency, parameters.q);
     break;
 
     case Type::BandStop:
-      setBandStop(parameters.sampleRate, parameters.frequency, parameters.q);      
+      setBandStop(c, parameters.sampleRate, parameters.frequency, parameters.q);      
     break;
 
     default:
       assert(false);
     break;
   }
+  return c;
 }
 
-sample_t AnalogFilter::process(sample_t in) {          
-  sample_t out = in * a0 + aDelay.get(0) * a1 + aDelay.get(1) * a2 - bDelay.get(0) * b1 - bDelay.get(1) * b2;
-  aDelay.push(in);
-  bDelay.push(out);    
-  return out;
-}
-
-void AnalogFilter::setByPass() {
-  a0 = 1;
-  a1 = a2 = b1 = b2 = 0;
-}
-
-void AnalogFilter::setAllPass(Frequency sampleRate, Frequency frequency) {
-  const double tmpTan = tan(std::numbers::pi * frequency.Hz() / sampleRate.Hz());
-  const double alpha = ( tmpTan - 1 ) / ( tmpTan + 1 );
-  a0 = alpha;
-  a1 = 1.;
-  b1 = alpha;    
-}
+AnalogFilter::AnalogFilter() = default;
 
-void AnalogFilter::setFirstOrderLowPass(Frequency sampleRate, Frequency frequency) {
-  const double Nyquist = sampleRate.Hz();
-  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
-  const double gamma = cos(f) / (1 + sin(f));
-  a0 = (1 - gamma) / 2.;
-  a1 = a0;
-  b1 = -gamma;      
-}
+AnalogFilter::AnalogFilter(Parameters parameters) {
+  reset(parameters);
+}    
 
-void AnalogFilter::setFirstOrderHighPass(Frequency sampleRate, Frequency frequency) {
-  const double Nyquist = sampleRate.Hz();
-  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
-  const double gamma = cos(f) / (1 + sin(f));
-  a0 = (1 + gamma) / 2.;
-  a1 = -a0;
-  b1 = -gamma;    
+void AnalogFilter::reset(Parameters parameters) {
+  setCoefficients(Coefficients::create(parameters));
 }
 
-void AnalogFilter::setLowPass(Frequency sampleRate, Frequency frequency, double q) {
-  const double Nyquist = sampleRate.Hz();
-  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
-  const double d = 1. / q;
-  const double beta = 0.5 * (1. - (d / 2.) * sin(f)) / (1 + (d / 2.) * sin(f));
-  const double gamma = (0.5 + beta) * cos(f);
-  a0 = (0.5 + beta - gamma) / 2.;
-  a1 = 2. * a0;
-  a2 = a0;
-  b1 = -2. * gamma;
-  b2 = 2 * beta;  
+void AnalogFilter::setCoefficients(const Coefficients& coefficients_p) {
+  coefficients = coefficients_p;
+  rampFrames = 0;
 }
 
-void AnalogFilter::setHighPass(Frequency sampleRate, Frequency frequency, double q) {
-  const double Nyquist = sampleRate.Hz();
-  const double f = 2 * std::numbers::pi * frequency.Hz() / Nyquist;
-  const double d = 1. / q;
-  const double beta = 0.5 * (1. - (d / 2.) * sin(f)) / (1 + (d / 2.) * sin(f));
-  const double gamma = (0.5 + beta) * cos(f);
-  a0 = (0.5 + beta + gamma) / 2.;
-  a1 = -2. * a0;
-  a2 = a0;
-  b1 = -2. * gamma;
-  b2 = 2 * beta;
-}
-
-void AnalogFilter::setLowShelf(Frequency sampleRate, Frequency frequency, Volume gain) {
-  const double K = tan(std::numbers::pi * frequency.Hz() / sampleRate.Hz());    
-  const double V = Volume::dB(std::fabs(gain.dB())).linear();    
-  if (gain.dB() >= 0) {    // boost
-    const double norm = 1 / (1 + sqrt(2) * K + K * K);
-    a0 = (1 + sqrt(2*V) * K + V * K * K) * norm;
-    a1 = 2 * (V * K * K - 1) * norm;
-    a2 = (1 - sqrt(2*V) * K + V * K * K) * norm;
-    b1 = 2 * (K * K - 1) * norm;
-    b2 = (1 - sqrt(2) * K + K * K) * norm;
-  }
-  else {    // cut
-    const double norm = 1 / (1 + sqrt(2*V) * K + V * K * K);
-    a0 = (1 + sqrt(2) * K + K * K) * norm;
-    a1 = 2 * (K * K - 1) * norm;
-    a2 = (1 - sqrt(2) * K + K * K) * norm;
-    b1 = 2 * (V * K * K - 1) * norm;
-    b2 = (1 - sqrt(2*V) * K + V * K * K) * norm;      
+void AnalogFilter::rampTo(const Coefficients& target, size_t frames) {
+  if(frames == 0) {
+    setCoefficients(target);
+    return;
   }
+  delta.a0 = (target.a0 - coefficients.a0) / frames;
+  delta.a1 = (target.a1 - coefficients.a1) / frames;
+  delta.a2 = (target.a2 - coefficients.a2) / frames;
+  delta.b1 = (target.b1 - coefficients.b1) / frames;
+  delta.b2 = (target.b2 - coefficients.b2) / frames;
+  rampFrames = frames;
 }
 
-void AnalogFilter::setHighShelf(Frequency sampleRate, Frequency frequency, Volume gain) {        
-  const double K = tan(std::numbers::pi * frequency.Hz() / sampleRate.Hz());    
-  const double V = Volume::dB(std::fabs(gain.dB())).linear();    
-  if (gain.dB() >= 0) {    // boost
-    const double norm = 1 / (1 + sqrt(2) * K + K * K);
-    a0 = (V + sqrt(2*V) * K + K * K) * norm;
-    a1 = 2 * (K * K - V) * norm;
-    a2 = (V - sqrt(2*V) * K + K * K) * norm;
-    b1 = 2 * (K * K - 1) * norm;
-    b2 = (1 - sqrt(2) * K + K * K) * norm;      
+sample_t AnalogFilter::process(sample_t in) {          
+  if(rampFrames > 0) {
+    coefficients.a0 += delta.a0;
+    coefficients.a1 += delta.a1;
+    coefficients.a2 += delta.a2;
+    coefficients.b1 += delta.b1;
+    coefficients.b2 += delta.b2;
+    rampFrames--;
   }
-  else {    // cut
-    const double norm = 1 / (V + sqrt(2*V) * K + K * K);
-    a0 = (1 + sqrt(2) * K + K * K) * norm;
-    a1 = 2 * (K * K - 1) * norm;
-    a2 = (1 - sqrt(2) * K + K * K) * norm;
-    b1 = 2 * (K * K - V) * norm;
-    b2 = (V - sqrt(2*V) * K + K * K) * norm;      
-  }    
-}
-
-void AnalogFilter::setBandPass(Frequency sampleRate, Frequency frequency, double q) {
-  const double Nyquist = sampleRate.Hz();
-  const double k = tan( (std::numbers::pi * frequency.Hz() / Nyquist ) );
-  const double delta = k * k * q + k + q;
-  a0 = k / delta;
-  a1 = 0.;
-  a2 = -k / delta;
-  b1 = ( 2 * q * (k * k - 1) ) / delta;
-  b2 = ( k * k * q - k + q ) / delta;    
+  sample_t out = in * coefficients.a0 + x1 * coefficients.a1 + x2 * coefficients.a2 - y1 * coefficients.b1 - y2 * coefficients.b2;
+  x2 = x1;
+  x1 = in;
+  y2 = y1;
+  y1 = out;
+  return out;
 }
 
-void AnalogFilter::setBandStop(Frequency sampleRate, Frequency frequency, double q) {
-  const double Nyquist = sampleRate.Hz();
-  const double k = tan( (std::numbers::pi * frequency.Hz() / Nyquist ) );
-  const double delta = k * k * q + k + q;
-  a0 = ( q * (k * k + 1) ) / delta;
-  a1 = ( 2 * q * (k * k - 1) ) / delta;
-  a2 = a0;
-  b1 = a1;
-  b2 = (k * k * q - k + q) / delta;    
+void AnalogFilter::process(std::span<const sample_t> in, std::span<sample_t> out) {
+  assert(in.size() == out.size());
+  size_t start = 0;
+  for(; start < in.size() && rampFrames > 0; start++) {
+    out[start] = process(in[start]);
+  }
+  // history and coefficients are copied to locals so they stay in registers for the whole block
+  const auto [a0, a1, a2, b1, b2] = coefficients;
+  sample_t lx1 = x1, lx2 = x2, ly1 = y1, ly2 = y2;
+  for(size_t i = start; i < in.size(); i++) {
+    const sample_t x = in[i];
+    const sample_t y = x * a0 + lx1 * a1 + lx2 * a2 - ly1 * b1 - ly2 * b2;
+    lx2 = lx1;
+    lx1 = x;
+    ly2 = ly1;
+    ly1 = y;
+    out[i] = y;
+  }
+  x1 = lx1;
+  x2 = lx2;
+  y1 = ly1;
+  y2 = ly2;
 }
 
 } // namespace ZAudio::Tools
\ No newline at end of file
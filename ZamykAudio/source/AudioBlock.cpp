@@ -0,0 +1,136 @@
+#include <ZAudio/AudioBlock.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ZAudio {
+
+
+// AudioBlockView-------------------------------------------------------------------------------------------
+
+AudioBlockView::AudioBlockView(std::span<sample_t> channel) :
+  numberOfChannels(1)
+{
+  channels[0] = channel;
+}
+
+AudioBlockView::AudioBlockView(std::span<sample_t> left, std::span<sample_t> right) :
+  numberOfChannels(2)
+{
+  assert(left.size() == right.size());
+  channels[0] = left;
+  channels[1] = right;
+}
+
+size_t AudioBlockView::getNumberOfChannels() const {
+  return numberOfChannels;
+}
+
+size_t AudioBlockView::getLength() const {
+  return numberOfChannels ? channels[0].size() : 0;
+}
+
+AudioBlockView AudioBlockView::subView(size_t offset, size_t length) const {
+  assert(offset + length <= getLength());
+  AudioBlockView view;
+  view.numberOfChannels = numberOfChannels;
+  for(size_t i = 0; i < numberOfChannels; i++) {
+    view.channels[i] = channels[i].subspan(offset, length);
+  }
+  return view;
+}
+
+void AudioBlockView::getFrame(size_t x, std::span<sample_t> out) const {
+  for(size_t i = 0; i < numberOfChannels; i++) {
+    out[i] = channels[i][x];
+  }
+}
+
+void AudioBlockView::setFrame(size_t x, std::span<const sample_t> in) const {
+  for(size_t i = 0; i < numberOfChannels; i++) {
+    channels[i][x] = in[i];
+  }
+}
+
+void AudioBlockView::clear() const {
+  for(size_t i = 0; i < numberOfChannels; i++) {
+    std::fill(channels[i].begin(), channels[i].end(), 0.);
+  }
+}
+
+// AudioBlock-----------------------------------------------------------------------------------------------
+
+AudioBlock::AudioBlock(size_t length) :
+  samples(Tools::MaxNumberOfChannels, length) {}
+
+void AudioBlock::resize(size_t length) {
+  samples.resize(Tools::MaxNumberOfChannels, length);
+}
+
+void AudioBlock::reserve(size_t length) {
+  if(length > getLength()) {
+    resize(length);
+  }
+}
+
+size_t AudioBlock::getLength() const {
+  return samples.getNumOfCollumns();
+}
+
+AudioBlockView AudioBlock::getView(FrameFormat format) {
+  return getView(format, getLength());
+}
+
+AudioBlockView AudioBlock::getView(FrameFormat format, size_t length) {
+  assert(length <= getLength());
+  if(Tools::numberOfChannels(format) == 1) {
+    return AudioBlockView(samples.getRow(0).first(length));
+  }
+  return AudioBlockView(samples.getRow(0).first(length), samples.getRow(1).first(length));
+}
+
+
+} // namespace ZAudio
+
+namespace ZAudio::Tools {
+
+
+void convertBlock(const AudioBlockView& in, FrameFormat inFormat, const AudioBlockView& out, FrameFormat outFormat, size_t frames) {
+  if(inFormat == outFormat) {
+    for(size_t i = 0; i < numberOfChannels(inFormat); i++) {
+      auto inChannel = in.getChannel(i);
+      auto outChannel = out.getChannel(i);
+      if(inChannel.data() != outChannel.data()) {
+        std::copy_n(inChannel.begin(), frames, outChannel.begin());
+      }
+    }
+  }
+  else {
+    switch (inFormat) {
+      case FrameFormat::Mono: {
+        auto inChannel = in.getChannel(0);
+        for(size_t i = 0; i < numberOfChannels(outFormat); i++) {
+          auto outChannel = out.getChannel(i);
+          if(inChannel.data() != outChannel.data()) {
+            std::copy_n(inChannel.begin(), frames, outChannel.begin());
+          }
+        }
+        break;
+      }
+      case FrameFormat::Stereo: {
+        auto left = in.getChannel(0);
+        auto right = in.getChannel(1);
+        auto outChannel = out.getChannel(0);
+        for(size_t i = 0; i < frames; i++) {
+          outChannel[i] = left[i] + right[i];
+        }
+        break;
+      }
+      default:
+        assert(false);
+    }
+  }
+}
+
+
+} // namespace ZAudio::Tools
@@ -1,51 +1,76 @@
 #include <ZAudio/AudioDecoder.h>
 
+#include <algorithm>
+
 
 namespace ZAudio {
 
 
-AsyncDecoder::AsyncDecoder(std::unique_ptr<AudioDecoder> decoder_p, Time bufferedTime, bool looped_p) :
+AsyncDecoder::AsyncDecoder(std::unique_ptr<AudioDecoder> decoder_p, Time bufferedTime, bool looped_p, ThreadTools::IOExecutor* executor_p) :
   decoder(std::move(decoder_p)),
-  buffer(bufferedTime.seconds() * decoder->getSampleRate().Hz() + 1),
+  buffer(std::max<size_t>(bufferedTime.seconds() * decoder->getSampleRate().Hz(), 2 * BlockFrames) * Tools::numberOfChannels(decoder->getFormat())),
   length(decoder->getLength()),
   sampleRate(decoder->getSampleRate()),
   format(decoder->getFormat()),
+  numberOfChannels(Tools::numberOfChannels(format)),
   loopStart(decoder->getLoopStart()),
   loopEnd(decoder->getLoopEnd()),
+  position(decoder->getPosition()),
   looped(looped_p),
-  thread(&AsyncDecoder::asyncThread, this)
+  executor(executor_p ? executor_p : &ThreadTools::IOExecutor::getShared())
 {
-  run = true;
-  ready = true;
+  lowWatermark = buffer.getFreeSpace() / 2;
+  decoder->setLooped(looped);
+  // first block is decoded here, so reading can start right away
+  refill(BlockFrames * numberOfChannels);
+  requestRefill();
 }
 
 AsyncDecoder::~AsyncDecoder() {
-  run = false;
-  thread.join();
+  executor->remove(*this);
 }
 
-bool AsyncDecoder::get(std::span<sample_t> out) {
-  if(error) {
-    return false;
+size_t AsyncDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  const size_t samples = frames * numberOfChannels;
+  if(seekDone != seekRequest) {
+    // decoder thread can push samples from after seek any time, so nothing is discarded until it tells how many are before it
+    std::fill_n(interleaved.begin(), samples, 0.);
+    requestRefill();
+    return frames;
+  }
+  if(popped < seekDonePushed) {
+    popped += buffer.discard(seekDonePushed - popped);
   }
-  for(size_t i = 0; i < Tools::numberOfChannels(format); i++) {
-    auto v = buffer.tryPop();
-    if(v) {
-      out[i] = *v;
+
+  // ended is read before buffer, so samples pushed before it was set are not missed
+  const bool decoderEnded_ = ended;
+  const size_t got = buffer.tryPopMany(interleaved.first(samples));
+  popped += got;
+  position += got / numberOfChannels;
+  if(looped && loopEnd > loopStart) {
+    while(position >= loopEnd) {
+      position -= loopEnd - loopStart;
     }
-    else {
-      if(ended) {
-        return false;
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  if((!decoderEnded_ && buffer.getReadable() < lowWatermark) || askSetLooped) {
+    requestRefill();
+  }
+  if(got < samples) {
+    if(decoderEnded_) {
+      return got / numberOfChannels;
     }
+    underruns++;
+    std::fill(interleaved.begin() + got, interleaved.begin() + samples, 0.);
   }
-  return true;
+  return frames;
 }
 
 void AsyncDecoder::seek(uint64_t position_p) {
   seekPosition = position_p;
-  askSeek = true;
+  position = position_p;
+  seekRequest++;
+  requestRefill();
 }
 
 uint64_t AsyncDecoder::getLength() {
@@ -75,78 +100,105 @@ bool AsyncDecoder::errorOccured() const {
 void AsyncDecoder::setLooped(bool looped_p) {
   looped = looped_p;
   askSetLooped = true;
+  requestRefill();
 }
 
 FrameFormat AsyncDecoder::getFormat() const {
   return format;
 }
 
-void AsyncDecoder::asyncThread() {
-  while(!ready) {
-    std::this_thread::yield() ;
-  }
-  std::vector<sample_t> vect(Tools::numberOfChannels(format));
-  size_t last = vect.size();
-  decoder->setLooped(looped);
-  while(run) {
-    while(true && !ended) {
-      if(last == vect.size()) {
-        if(!decoder->get(vect)) {
-          ended = true;
-          break;
-        }
-        last = 0;
-      }
-
-      bool full = false;
-      while(last < vect.size()) {
-        if(!buffer.tryPush(vect[last])) {
-          full = true;
-          break;
-        }
-        last++;
-        if(!run) {
-          return;
-        }
-      }
+uint64_t AsyncDecoder::getUnderruns() const {
+  return underruns;
+}
 
-      if(!run) {
-        return;
-      }
-      if(full) {
-        break;
-      }
+size_t AsyncDecoder::getBufferedFrames() const {
+  return buffer.getReadable() / numberOfChannels;
+}
 
-    }
+double AsyncDecoder::getBufferedSeconds() const {
+  return buffer.getReadable() / numberOfChannels / sampleRate.Hz();
+}
 
-    if(decoder->errorOccured()) {
-      error = true;
-    }
+bool AsyncDecoder::service() {
+  return refill(ServiceBlocks * BlockFrames * numberOfChannels);
+}
 
-    position = decoder->getPosition();
+void AsyncDecoder::requestRefill() {
+  // if executor is busy, request is repeated on next read
+  executor->request(*this);
+}
 
-    if(askSeek) {
+bool AsyncDecoder::refill(size_t limit) {
+  size_t pushedNow = 0;
+  while(pushedNow < limit) {
+    const uint32_t request = seekRequest;
+    if(request != seekDone) {
       decoder->seek(seekPosition);
-      askSeek = false;
+      pending.clear();
+      pendingOffset = 0;
+      decoderEnded = false;
       ended = false;
       error = false;
+      seekDonePushed = pushed;
+      seekDone = request;
     }
-    if(askSetLooped) {
+    if(askSetLooped.exchange(false)) {
       decoder->setLooped(looped);
-      askSetLooped = false;
+      if(looped && decoderEnded && !error) {
+        decoderEnded = false;
+        ended = false;
+      }
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    if(pendingOffset == pending.size()) {
+      if(decoderEnded) {
+        ended = true;
+        return false;
+      }
+      pending.resize(BlockFrames * numberOfChannels);
+      const size_t got = decoder->read(pending, BlockFrames);
+      pending.resize(got * numberOfChannels);
+      pendingOffset = 0;
+      if(got < BlockFrames) {
+        decoderEnded = true;
+        error = decoder->errorOccured();
+      }
+      continue;
+    }
+
+    // only whole frames are pushed, so reader never gets part of frame
+    const size_t space = buffer.getFreeSpace() / numberOfChannels * numberOfChannels;
+    const size_t n = std::min(pending.size() - pendingOffset, space);
+    if(n == 0) {
+      return false;
+    }
+    buffer.tryPushMany(std::span<const sample_t>(pending).subspan(pendingOffset, n));
+    pendingOffset += n;
+    pushed += n;
+    pushedNow += n;
   }
+  return true;
 }
 
 
 ResultValue<SoundBuffer> decodeSound(AudioDecoder& decoder) {
   SoundBuffer sound(decoder.getSampleRate(), decoder.getFormat(), decoder.getLength(), decoder.getLoopStart(), decoder.getLoopEnd());
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame;
-  size_t i = 0;
-  while(decoder.get(frame)) {
-    sound.setFrame(i, frame.begin());
-    i++;
+  static constexpr size_t BlockLength = 4096;
+  const size_t channels = sound.getNumberOfChannels();
+  std::vector<sample_t> block(BlockLength * channels);
+  size_t position = 0;
+  while(position < sound.getLength()) {
+    const size_t got = decoder.read(block, std::min(BlockLength, sound.getLength() - position));
+    for(size_t c = 0; c < channels; c++) {
+      auto samples = sound.getChannel(c).subspan(position, got);
+      for(size_t i = 0; i < got; i++) {
+        samples[i] = block[i * channels + c];
+      }
+    }
+    position += got;
+    if(got == 0) {
+      break;
+    }
   }
   if(decoder.errorOccured()) {
     return Result::error("error during decoding sound");
@@ -161,37 +213,33 @@ FileInput::Parameters::Parameters(bool looped_p, Time position_p, double tempo_p
   tempo(tempo_p),
   async(async_p) {}
 
-FileInput::FileInput(std::unique_ptr<AudioDecoder> decoder_p, const Parameters& parameters) :
-  decoder( ( parameters.async ? std::make_unique<AsyncDecoder>(std::move(decoder_p), Time::seconds(1), parameters.looped) : std::move(decoder_p) ) ), looped(parameters.looped), tempo(parameters.tempo)
-{
+FileInput::FileInput(std::unique_ptr<AudioDecoder> decoder_p, const Parameters& parameters) : looped(parameters.looped), tempo(parameters.tempo) {
+  // decoder is positioned before AsyncDecoder starts reading it
   if(parameters.position.miliseconds() > 1) {
-    decoder->seek(parameters.position.seconds() * decoder->getSampleRate().Hz());
+    decoder_p->seek(parameters.position.seconds() * decoder_p->getSampleRate().Hz());
   }
-  decoder->setLooped(looped);
+  decoder_p->setLooped(looped);
+  decoder = parameters.async ? std::make_unique<AsyncDecoder>(std::move(decoder_p), Time::seconds(1), looped) : std::move(decoder_p);
 }
 
 void FileInput::get(std::span<sample_t> out) {
   std::array<sample_t, Tools::MaxNumberOfChannels> frame;
 
   while(playing) {
-    if(sampleRateConverters.front().outReady()) {
+    if(resampler.outReady()) {
       break;
     }
     if(!decoder->get(frame)) {
       ended = true;
       return;
     }
-    for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-      sampleRateConverters[i].push(frame[i]);
-    }
-  }
-  for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-    out[i] = sampleRateConverters[i].get();
+    resampler.push(frame);
   }
+  resampler.get(out);
 
   if(fadingOut) {
     auto v = volume.update();
-    for(size_t i = 0; i < sampleRateConverters.size(); i++) {
+    for(size_t i = 0; i < resampler.getNumberOfChannels(); i++) {
       out[i] *= v.linear();
     }
     if(!volume.hasChanged()) {
@@ -202,7 +250,7 @@ void FileInput::get(std::span<sample_t> out) {
 
 void FileInput::setSampleRate(Frequency sampleRate_p) {
   sampleRate = sampleRate_p;
-  sampleRateConverters.resize(Tools::numberOfChannels(decoder->getFormat()), Tools::SampleRateConverter(decoder->getSampleRate(), sampleRate / tempo));  
+  resampler = Tools::Resampler(Tools::numberOfChannels(decoder->getFormat()), decoder->getSampleRate(), sampleRate / tempo);
 }
 
 static Time sampleToTime(uint32_t position, Frequency sampleRate) {
@@ -230,10 +278,8 @@ void FileInput::setParameter(size_t id, ParameterValue value) {
       break;
 
     case TempoID:
-      for(auto& sampleRateConverter : sampleRateConverters) {
-        tempo = value.getNonInteger();
-        sampleRateConverter.setOutSampleRateNoFilterUpdate(sampleRate / tempo);
-      }
+      tempo = value.getNonInteger();
+      resampler.setOutSampleRateNoFilterUpdate(sampleRate / tempo);
       break;
 
     case FadeOutID:
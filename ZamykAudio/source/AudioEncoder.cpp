@@ -1,5 +1,9 @@
 #include <ZAudio/AudioEncoder.h>
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+
 namespace ZAudio {
 
 
@@ -18,33 +22,32 @@ Result encodeSound(AudioEncoder& encoder, const SoundBuffer& soundBuffer) {
 }
 
 
-AsyncEncoder::AsyncEncoder(std::unique_ptr<AudioEncoder> encoder_p, Time bufferedTime) : 
+AsyncEncoder::AsyncEncoder(std::unique_ptr<AudioEncoder> encoder_p, Time bufferedTime, ThreadTools::IOExecutor* executor_p) : 
   encoder(std::move(encoder_p)), 
-  buffer(bufferedTime.seconds() * encoder->getSampleRate().Hz() + 1), 
+  buffer(std::max<size_t>(bufferedTime.seconds() * encoder->getSampleRate().Hz(), BlockFrames) * Tools::numberOfChannels(encoder->getFormat()) + 1), 
   sampleRate(encoder->getSampleRate()),
   format(encoder->getFormat()),
-  thread(&AsyncEncoder::asyncThread, this)
-{
-  run = true;
-  ready = true;  
-}
+  numberOfChannels(Tools::numberOfChannels(format)),
+  executor(executor_p ? executor_p : &ThreadTools::IOExecutor::getShared()),
+  block(ServiceBlocks * BlockFrames * numberOfChannels) {}
 
 AsyncEncoder::~AsyncEncoder() {
-  run = false;
-  thread.join();
+  executor->remove(*this);
+  drain(std::numeric_limits<size_t>::max());
 }
 
 void AsyncEncoder::send(std::span<const sample_t> out) {
-  for(size_t i = 0; i < Tools::numberOfChannels(format); i++) {
-    while(true) {
-      if(buffer.tryPush(out[i])) {
-        break;
-      } 
-      if(error || ended_) {
-        break;
-      }
-      std::this_thread::yield();
+  // whole frame is pushed at once, so executor never sees half of it
+  while(buffer.getFreeSpace() < numberOfChannels) {
+    if(error || ended_) {
+      return;
     }
+    executor->request(*this);
+    std::this_thread::yield();
+  }
+  buffer.tryPushMany(out.first(numberOfChannels));
+  if(buffer.getReadable() >= BlockFrames * numberOfChannels) {
+    executor->request(*this);
   }
 }
 
@@ -64,38 +67,29 @@ bool AsyncEncoder::ended() const {
   return ended_;
 }
 
-void AsyncEncoder::asyncThread() {
-  while(!ready) {
-    std::this_thread::yield();
-  }
-  std::vector<sample_t> frame(Tools::numberOfChannels(format));
-  size_t last = 0;  
-  while(run) {
-        
-    while(last < frame.size()) {
-      while(true) {
-        if(auto tmp = buffer.tryPop(); tmp) {
-          frame[last++] = *tmp;
-          break;
-        }
-        if(!run) {
-          return;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        //std::this_thread::yield();
-      }
-    }
-    if(last == frame.size()) {
-      encoder->send(frame);
-      last = 0;
-    }
-    if(encoder->ended()) {
-      ended_ = true;
+double AsyncEncoder::getBufferedSeconds() const {
+  // the less free space, the sooner send would wait
+  return buffer.getFreeSpace() / numberOfChannels / sampleRate.Hz();
+}
+
+bool AsyncEncoder::service() {
+  drain(ServiceBlocks * BlockFrames);
+  return buffer.getReadable() >= BlockFrames * numberOfChannels;
+}
+
+void AsyncEncoder::drain(size_t limit) {
+  while(limit > 0 && !ended_ && !error) {
+    const size_t frames = std::min({limit, buffer.getReadable() / numberOfChannels, block.size() / numberOfChannels});
+    if(frames == 0) {
+      return;
     }
-    if(encoder->errorOccured()) {
-      error = true;
+    buffer.tryPopMany(std::span<sample_t>(block).first(frames * numberOfChannels));
+    for(size_t i = 0; i < frames; i++) {
+      encoder->send(std::span<const sample_t>(block).subspan(i * numberOfChannels, numberOfChannels));
     }
-    std::this_thread::yield();
+    limit -= frames;
+    ended_ = encoder->ended();
+    error = encoder->errorOccured();
   }
 }
 
@@ -106,20 +100,16 @@ void FileOutput::send(std::span<const sample_t> in) {
   if(stop) {
     return;
   }
-  for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-    sampleRateConverters[i].push(in[i]);
-  }  
-  while(sampleRateConverters.front().outReady()) {
+  resampler.push(in);
+  while(resampler.outReady()) {
     std::array<sample_t, Tools::MaxNumberOfChannels> frame;
-    for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-      frame[i] = sampleRateConverters[i].get();
-    }
+    resampler.get(frame);
     encoder->send(frame);
   }
 }
 
 void FileOutput::setSampleRate(Frequency sampleRate) {
-  sampleRateConverters.resize(Tools::numberOfChannels(encoder->getFormat()), Tools::SampleRateConverter(sampleRate, encoder->getSampleRate()));
+  resampler = Tools::Resampler(Tools::numberOfChannels(encoder->getFormat()), sampleRate, encoder->getSampleRate());
 }
 
 void FileOutput::setParameter(size_t id, ParameterValue value) {
@@ -1,7 +1,10 @@
 #include <ZAudio/AudioEngine.h>
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <utility>
 
 namespace ZAudio {
@@ -11,17 +14,17 @@ namespace ZAudio {
 
 
 AudioEngineInput::AudioEngineInput(InputHandle handle_p) :
-  handle(handle_p)
-{
-  std::fill(cachedFrame.begin(), cachedFrame.end(), 0.);
-}
+  handle(handle_p) {}
 
-void AudioEngineInput::get(std::span<sample_t> out) {
+AudioBlockView AudioEngineInput::get(size_t frames) {
+  cachedBlock.reserve(frames);
+  auto view = cachedBlock.getView(handle.get().getFormat(), frames);
   if(!cached) {
-    handle.get().get(cachedFrame);
+    view.clear();
+    handle.get().getBlock(view, frames);
     cached = true;
   }
-  std::copy(cachedFrame.begin(), cachedFrame.end(), out.begin());
+  return view;
 }
 
 void AudioEngineInput::resetCached() {
@@ -32,6 +35,10 @@ AudioInput& AudioEngineInput::getInput() {
   return handle.get();
 }
 
+InputHandle& AudioEngineInput::getHandle() {
+  return handle;
+}
+
 int32_t AudioEngineInput::getUseCount() const {
   return useCount;
 }
@@ -60,21 +67,26 @@ bool AudioEngineInput::isPlaying() const {
 
 
 AudioEngineOutput::AudioEngineOutput(OutputHandle handle_p) :
-  handle(handle_p)
-{
-  std::fill(cachedFrame.begin(), cachedFrame.end(), 0.);
-}
+  handle(handle_p) {}
 
 
-void AudioEngineOutput::send(std::span<const sample_t> out) {
-  for(size_t i = 0; i < cachedFrame.size(); i++) {
-    cachedFrame[i] += out[i];
+void AudioEngineOutput::send(const AudioBlockView& out, size_t frames) {
+  cachedBlock.reserve(frames);
+  auto view = cachedBlock.getView(handle.get().getFormat(), frames);
+  for(size_t channel = 0; channel < view.getNumberOfChannels(); channel++) {
+    auto cachedChannel = view.getChannel(channel);
+    auto outChannel = out.getChannel(channel);
+    for(size_t i = 0; i < frames; i++) {
+      cachedChannel[i] += outChannel[i];
+    }
   }
 }
 
-void AudioEngineOutput::finishedFrame() {
-  handle.get().send(cachedFrame);
-  std::fill(cachedFrame.begin(), cachedFrame.end(), 0.);
+void AudioEngineOutput::finishedBlock(size_t frames) {
+  cachedBlock.reserve(frames);
+  auto view = cachedBlock.getView(handle.get().getFormat(), frames);
+  handle.get().sendBlock(view, frames);
+  view.clear();
 }
 
 OutputHandle& AudioEngineOutput::getOutput() {
@@ -135,87 +147,120 @@ void Mixer::stop(AudioEngineInputID input) {
   }
 }
 
-void Mixer::get(std::span<sample_t> out) {
-  // Mixer is not currently playing anything.
-  if (playing.empty() && tails.empty()) {
-    if (timeRemaining == 0) {
-      std::fill(out.begin(), out.end(), 0.);
-      return;
-    }
-    else {
-      --timeRemaining;
-    }
-  }
-  else {
-    timeRemaining = mixerEffect.ptr->getTailTime();
+void Mixer::get(const AudioBlockView& out, size_t frames) {
+  for(size_t i = 0; i < playing.size(); i++) {
+    processInput(i, frames);
   }
+  mix(out, frames);
+  removeEnded();
+}
 
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame1;
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame2;
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame3;
-  std::fill(frame3.begin(), frame3.end(), 0.);
+size_t Mixer::getNumberOfInputs() const {
+  return playing.size();
+}
 
+AudioEngineInput& Mixer::getInput(size_t index) {
+  return inputs->at(playing[index].input);
+}
 
-  // fill output frame from inputs
-  for(auto& p : playing) {
-    std::fill(frame1.begin(), frame1.end(), 0.);
-    std::fill(frame2.begin(), frame2.end(), 0.);
+const Effect* Mixer::getInputEffect(size_t index) const {
+  return playing[index].effect.ptr.get();
+}
 
-    auto& input = (*inputs)[p.input];
-    auto& effect = p.effect.get();
+void Mixer::getMixEffects(std::vector<const Effect*>& effects) const {
+  effects.push_back(mixerEffect.ptr.get());
+  for(auto& tail : tails) {
+    effects.push_back(tail.effect.ptr.get());
+  }
+}
 
-    input.get(frame1);
+void Mixer::processInput(size_t index, size_t frames) {
+  auto& p = playing[index];
+  auto& input = getInput(index);
+  auto& effect = p.effect.get();
 
-    if(input.getInput().errorOccured()) {
-      error = true;
-    }
+  auto inputView = input.get(frames);
 
-    if(input.getInput().isPlaying() && p.playing == false) {
-      p.playing = true;
-    }
+  if(input.getInput().errorOccured()) {
+    p.error = true;
+  }
 
-    if(!input.getInput().isPlaying()) {
-      if(p.playing) {
-        p.playing = false;
-        p.timeRemaining = p.effect.get().getTailTime();
-      }
+  if(input.getInput().isPlaying() && p.playing == false) {
+    p.playing = true;
+  }
 
-      if(p.timeRemaining != 0) {
-        p.timeRemaining--;
-      }
+  if(!input.getInput().isPlaying()) {
+    if(p.playing) {
+      p.playing = false;
+      p.timeRemaining = effect.getTailTime();
     }
 
-    // convert input format to effect input format and process
-    Tools::convertFrames(frame1, input.getInput().getFormat(), frame2, effect.getInputFormat());
-    effect.process(frame2, frame1);
+    p.timeRemaining -= std::min<uint32_t>(p.timeRemaining, frames);
+  }
 
-    // convert to output format of mixer
-    Tools::convertFrames(frame1, effect.getOutputFormat(), frame2, mixerEffect.get().getInputFormat());
+  // convert input format to effect input format, process in place and convert to input format of mixer effect
+  const FrameFormat mixerInputFormat = mixerEffect.get().getInputFormat();
+  p.block.reserve(frames);
+  auto effectInput = p.block.getView(effect.getInputFormat(), frames);
+  auto effectOutput = p.block.getView(effect.getOutputFormat(), frames);
+  Tools::convertBlock(inputView, input.getInput().getFormat(), effectInput, effect.getInputFormat(), frames);
+  effect.processBlock(effectInput, effectOutput, frames);
+  Tools::convertBlock(effectOutput, effect.getOutputFormat(), p.block.getView(mixerInputFormat, frames), mixerInputFormat, frames);
+}
 
-    for(size_t i = 0; i < Tools::numberOfChannels(format); i++) {
-      frame3[i] += frame2[i];
+void Mixer::mix(const AudioBlockView& out, size_t frames) {
+  // Mixer is not currently playing anything.
+  if (playing.empty() && tails.empty()) {
+    if (timeRemaining == 0) {
+      out.clear();
+      return;
+    }
+    else {
+      timeRemaining -= std::min<uint32_t>(timeRemaining, frames);
     }
   }
+  else {
+    timeRemaining = mixerEffect.ptr->getTailTime();
+  }
 
-  // delete unused from playing
-  for(int32_t i = 0; i < static_cast<int32_t>(playing.size()); i++) {
-    if((*inputs)[playing[i].input].died() && playing[i].timeRemaining == 0) {
-      (*inputs)[playing[i].input].decrementUseCount();
-      std::swap(playing.back(), playing[i]);
-      playing.pop_back();
-      i--;
+  block1.reserve(frames);
+  block2.reserve(frames);
+  sumBlock.reserve(frames);
+
+  const FrameFormat mixerInputFormat = mixerEffect.get().getInputFormat();
+  auto sum = sumBlock.getView(mixerInputFormat, frames);
+  sum.clear();
+
+  auto addToSum = [&](const AudioBlockView& view) {
+    for(size_t channel = 0; channel < sum.getNumberOfChannels(); channel++) {
+      auto sumChannel = sum.getChannel(channel);
+      auto viewChannel = view.getChannel(channel);
+      for(size_t i = 0; i < frames; i++) {
+        sumChannel[i] += viewChannel[i];
+      }
+    }
+  };
+
+  // add inputs processed by processInput
+  for(auto& p : playing) {
+    addToSum(p.block.getView(mixerInputFormat, frames));
+    if(p.error) {
+      error = true;
     }
   }
 
   // add tail sounds (only these that were stopped, paused are working autoamtically with playing)
   for(auto& tail : tails) {
-    std::fill(frame1.begin(), frame1.end(), 0.);
-    tail.effect.get().process(frame1, frame2);
-    Tools::convertFrames(frame2, tail.effect.get().getOutputFormat(), frame1, mixerEffect.get().getInputFormat());
-    for(size_t i = 0; i < Tools::numberOfChannels(format); i++) {
-      frame3[i] += frame1[i];
-    }
-    tail.timeRemaining--;
+    auto& effect = tail.effect.get();
+    auto effectInput = block1.getView(effect.getInputFormat(), frames);
+    auto effectOutput = block2.getView(effect.getOutputFormat(), frames);
+    effectInput.clear();
+    effect.processBlock(effectInput, effectOutput, frames);
+
+    auto converted = block1.getView(mixerInputFormat, frames);
+    Tools::convertBlock(effectOutput, effect.getOutputFormat(), converted, mixerInputFormat, frames);
+    addToSum(converted);
+    tail.timeRemaining -= std::min<uint32_t>(tail.timeRemaining, frames);
   }
 
   // remove ended tails
@@ -227,7 +272,19 @@ void Mixer::get(std::span<sample_t> out) {
     }
   }
 
-  mixerEffect.ptr->process(frame3, out);
+  AudioBlockView outView = out;
+  mixerEffect.ptr->processBlock(sum, outView, frames);
+}
+
+void Mixer::removeEnded() {
+  for(int32_t i = 0; i < static_cast<int32_t>(playing.size()); i++) {
+    if((*inputs)[playing[i].input].died() && playing[i].timeRemaining == 0) {
+      (*inputs)[playing[i].input].decrementUseCount();
+      std::swap(playing.back(), playing[i]);
+      playing.pop_back();
+      i--;
+    }
+  }
 }
 
 bool Mixer::errorOccured() const {
@@ -249,20 +306,44 @@ int32_t Mixer::getTotalPlaying() const {
 
 // AudioEngine----------------------------------------------------------------------------------------------
 
-AudioEngine::AudioEngine(Frequency sampleRate_p, int32_t simultaneousPlayingLimit_p) :
+AudioEngine::Parameters::Parameters(int32_t simultaneousPlayingLimit_p, size_t blockSize_p, size_t workerThreads_p, bool offline_p, QueuePolicy queuePolicy_p) :
+  simultaneousPlayingLimit(simultaneousPlayingLimit_p),
+  blockSize(blockSize_p),
+  workerThreads(workerThreads_p),
+  offline(offline_p),
+  queuePolicy(queuePolicy_p) {}
+
+AudioEngine::AudioEngine(Frequency sampleRate_p, int32_t simultaneousPlayingLimit_p, size_t blockSize_p, size_t workerThreads_p) :
+  AudioEngine(sampleRate_p, Parameters(simultaneousPlayingLimit_p, blockSize_p, workerThreads_p)) {}
+
+AudioEngine::AudioEngine(Frequency sampleRate_p, const Parameters& parameters) :
   queue(QueueSize),
-  outQueue(OutQueueSize),
+  queuePolicy(parameters.queuePolicy),
+  overflow(std::make_unique<CommandBatch>()),
+  handledOverflow(std::make_unique<CommandBatch>()),
+  outputBlock(parameters.blockSize),
   sampleRate(sampleRate_p),
-  simultaneousPlayingLimit(simultaneousPlayingLimit_p),
-  thread(&AudioEngine::engineThread, this)
+  simultaneousPlayingLimit(parameters.simultaneousPlayingLimit),
+  blockSize(parameters.blockSize),
+  offline(parameters.offline),
+  workers(parameters.workerThreads)
 {
-  ThreadTools::setHighPriority(thread);
+  scheduled.reserve(QueueSize);
+  if(!offline) {
+    thread = std::thread(&AudioEngine::engineThread, this);
+    ThreadTools::setHighPriority(thread);
+  }
   ready = true;
 }
 
 AudioEngine::~AudioEngine() {
   run = false;
-  thread.join();
+  if(auto* signal = clockSignal.load()) {
+    signal->notify();
+  }
+  if(thread.joinable()) {
+    thread.join();
+  }
 }
 
 MixerHandle AudioEngine::addMixer(FrameFormat format) {
@@ -270,7 +351,7 @@ MixerHandle AudioEngine::addMixer(FrameFormat format) {
   Command command;
   command.type = Command::Type::AddMixer;
   command.handle = handle;
-  queue.waitAndPush(command);
+  pushCommand(command);
   return handle;
 }
 
@@ -282,7 +363,7 @@ MixerHandle AudioEngine::addMixer(EffectHandle effect) {
   Command command;
   command.type = Command::Type::AddMixer;
   command.handle = handle;
-  queue.waitAndPush(command);
+  pushCommand(command);
   return handle;
 }
 
@@ -294,7 +375,7 @@ void AudioEngine::addMixerOutput(const MixerHandle& input, const OutputHandle& o
   command.type = Command::Type::AddMixerOutput;
   command.handle = input;
   command.value1 = output;
-  queue.waitAndPush(command);
+  pushCommand(command);
 }
 
 void AudioEngine::removeMixerOutput(const MixerHandle& mixer, const OutputHandle& output) {
@@ -305,7 +386,7 @@ void AudioEngine::removeMixerOutput(const MixerHandle& mixer, const OutputHandle
   command.type = Command::Type::RemoveMixerOutput;
   command.handle = mixer;
   command.value1 = output;
-  queue.waitAndPush(command);
+  pushCommand(command);
 }
 
 void AudioEngine::setMixerEffect(const MixerHandle& mixer, const EffectHandle& effect) {
@@ -316,10 +397,22 @@ void AudioEngine::setMixerEffect(const MixerHandle& mixer, const EffectHandle& e
   command.type = Command::Type::SetMixerEffect;
   command.handle = mixer;
   command.value1 = effect;
-  queue.waitAndPush(command);
+  pushCommand(command);
 }
 
 void AudioEngine::play(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect) {
+  playAt(mixer, input, effect, 0);
+}
+
+void AudioEngine::play(const MixerHandle& mixer, const InputHandle& input) {
+  playAt(mixer, input, 0);
+}
+
+void AudioEngine::stop(const MixerHandle& mixer, const InputHandle& input) {
+  stopAt(mixer, input, 0);
+}
+
+void AudioEngine::playAt(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect, uint64_t frame) {
   if(!mixer || !input || !effect) {
     return;
   }
@@ -328,22 +421,18 @@ void AudioEngine::play(const MixerHandle& mixer, const InputHandle& input, const
   command.handle = mixer;
   command.value1 = input;
   command.value2 = effect;
-  queue.waitAndPush(command);
+  command.frame = frame;
+  pushCommand(command);
 }
 
-void AudioEngine::play(const MixerHandle& mixer, const InputHandle& input) {
+void AudioEngine::playAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame) {
   if(!mixer || !input) {
     return;
   }
-  Command command;
-  command.type = Command::Type::Play;
-  command.handle = mixer;
-  command.value1 = input;
-  command.value2 = EffectHandle(std::make_shared<BypassEffect>(input.get().getFormat(), mixer.get().getFormat()));
-  queue.waitAndPush(command);
+  playAt(mixer, input, EffectHandle(std::make_shared<BypassEffect>(input.get().getFormat(), mixer.get().getFormat())), frame);
 }
 
-void AudioEngine::stop(const MixerHandle& mixer, const InputHandle& input) {
+void AudioEngine::stopAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame) {
   if(!mixer || !input) {
     return;
   }
@@ -351,7 +440,8 @@ void AudioEngine::stop(const MixerHandle& mixer, const InputHandle& input) {
   command.type = Command::Type::Stop;
   command.handle = mixer;
   command.value1 = input;
-  queue.waitAndPush(command);
+  command.frame = frame;
+  pushCommand(command);
 }
 
 EffectHandle AudioEngine::addEffect(std::unique_ptr<Effect> effect) {
@@ -359,15 +449,17 @@ EffectHandle AudioEngine::addEffect(std::unique_ptr<Effect> effect) {
     return EffectHandle();
   }
   effect->setSampleRate(sampleRate);
+  effect->setRealTime(!offline);
   EffectHandle handle(std::move(effect));
+  handle.state = std::make_shared<PublishedState>();
   Command command;
   command.type = Command::Type::AddEffect;
   command.handle = handle;
-  queue.waitAndPush(command);
+  pushCommand(command);
   return handle;
 }
 
-void AudioEngine::setEffectParameter(const EffectHandle& handle, size_t parameterID, const ParameterValue& v) {
+void AudioEngine::setEffectParameter(const EffectHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame) {
   if(!handle) {
     return;
   }
@@ -376,10 +468,11 @@ void AudioEngine::setEffectParameter(const EffectHandle& handle, size_t paramete
   command.handle = handle;
   command.ind1 = parameterID;
   command.value1 = v;
-  queue.waitAndPush(command);
+  command.frame = frame;
+  pushCommand(command);
 }
 
-void AudioEngine::setMultiEffectParameter(const EffectHandle& handle, size_t effectID, size_t parameterID, const ParameterValue& v) {
+void AudioEngine::setMultiEffectParameter(const EffectHandle& handle, size_t effectID, size_t parameterID, const ParameterValue& v, uint64_t frame) {
   if(!handle) {
     return;
   }
@@ -389,7 +482,8 @@ void AudioEngine::setMultiEffectParameter(const EffectHandle& handle, size_t eff
   command.ind1 = effectID;
   command.ind2 = parameterID;
   command.value1 = v;
-  queue.waitAndPush(command);
+  command.frame = frame;
+  pushCommand(command);
 }
 
 InputHandle AudioEngine::addInput(std::unique_ptr<AudioInput> input) {
@@ -401,11 +495,11 @@ InputHandle AudioEngine::addInput(std::unique_ptr<AudioInput> input) {
   Command command;
   command.type = Command::Type::AddInput;
   command.handle = handle;
-  queue.waitAndPush(command);
+  pushCommand(command);
   return handle;
 }
 
-void AudioEngine::setInputParameter(const InputHandle& handle, size_t parameterID, const ParameterValue& v ) {
+void AudioEngine::setInputParameter(const InputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame) {
   if(!handle) {
     return;
   }
@@ -414,7 +508,8 @@ void AudioEngine::setInputParameter(const InputHandle& handle, size_t parameterI
   command.handle = handle;
   command.ind1 = parameterID;
   command.value1 = v;
-  queue.waitAndPush(command);
+  command.frame = frame;
+  pushCommand(command);
 }
 
 OutputHandle AudioEngine::addOutput(std::unique_ptr<AudioOutput> output) {
@@ -426,11 +521,11 @@ OutputHandle AudioEngine::addOutput(std::unique_ptr<AudioOutput> output) {
   Command command;
   command.type = Command::Type::AddOutput;
   command.handle = handle;
-  queue.waitAndPush(command);
+  pushCommand(command);
   return handle;
 }
 
-void AudioEngine::setOutputParameter(const OutputHandle& handle, size_t parameterID, const ParameterValue& v) {
+void AudioEngine::setOutputParameter(const OutputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame) {
   if(!handle) {
     return;
   }
@@ -439,65 +534,235 @@ void AudioEngine::setOutputParameter(const OutputHandle& handle, size_t paramete
   command.handle = handle;
   command.ind1 = parameterID;
   command.value1 = v;
-  queue.waitAndPush(command);
+  command.frame = frame;
+  pushCommand(command);
+}
+
+void AudioEngine::submit(CommandBatch batch) {
+  if(batch.empty()) {
+    return;
+  }
+  batch.compact();
+  Command command;
+  command.type = Command::Type::Batch;
+  command.batch = std::move(batch.commands);
+  pushCommand(command);
 }
 
 bool AudioEngine::isPlaying(const InputHandle& handle) {
   if(!handle) {
     return false;
   }
+  if(!offline) {
+    // input that engine doesn't have isn't playing
+    if(auto state = handle.state->getSnapshot()) {
+      return state->published && state->playing;
+    }
+  }
   Command command;
   command.type = Command::Type::AskIsPlaying;
   command.handle = handle;
-  queue.waitAndPush(command);
-  return outQueue.waitAndPop().getBoolean();
+  return pushQuery(command).getBoolean();
 }
 
 bool AudioEngine::hasEnded(const OutputHandle& handle) {
   if(!handle) {
     return true;
   }
+  if(!offline) {
+    if(auto state = handle.state->getSnapshot(); state && state->published) {
+      return state->ended;
+    }
+  }
   Command command;
   command.type = Command::Type::AskHasEnded;
   command.handle = handle;
-  queue.waitAndPush(command);
-  return outQueue.waitAndPop().getBoolean();
+  return pushQuery(command).getBoolean();
 }
 
 ParameterValue AudioEngine::getOutputValue(const InputHandle& handle, size_t id) {
   if(!handle) {
     return ParameterValue();
   }
+  if(!offline) {
+    if(auto value = handle.state->getValue(id)) {
+      return *value;
+    }
+  }
   Command command;
   command.type = Command::Type::GetAudioInputOutputValue;
   command.handle = handle;
   command.ind1 = id;
-  queue.waitAndPush(command);
-  return outQueue.waitAndPop();
+  return pushQuery(command);
 }
 
 ParameterValue AudioEngine::getOutputValue(const OutputHandle& handle, size_t id) {
   if(!handle) {
     return ParameterValue();
   }
+  if(!offline) {
+    if(auto value = handle.state->getValue(id)) {
+      return *value;
+    }
+  }
   Command command;
   command.type = Command::Type::GetAudioOutputOutputValue;
   command.handle = handle;
   command.ind1 = id;
-  queue.waitAndPush(command);
-  return outQueue.waitAndPop();
+  return pushQuery(command);
 }
 
 ParameterValue AudioEngine::getOutputValue(const EffectHandle& handle, size_t id) {
   if(!handle) {
     return ParameterValue();
   }
+  if(!offline && handle.state) {
+    if(auto value = handle.state->getValue(id)) {
+      return *value;
+    }
+  }
   Command command;
   command.type = Command::Type::GetEffectOutputValue;
   command.handle = handle;
   command.ind1 = id;
-  queue.waitAndPush(command);
-  return outQueue.waitAndPop();
+  return pushQuery(command);
+}
+
+size_t AudioEngine::getBlockSize() const {
+  return blockSize;
+}
+
+size_t AudioEngine::getNumberOfWorkerThreads() const {
+  return workers.getNumberOfThreads();
+}
+
+uint64_t AudioEngine::getNumberOfDroppedCommands() const {
+  return droppedCommands;
+}
+
+uint64_t AudioEngine::getFrame() const {
+  return renderedFrames;
+}
+
+void AudioEngine::render(size_t frames) {
+  assert(offline);
+  while(frames) {
+    runScheduledCommands();
+    removeUnusedInputs();
+    const size_t blockFrames = std::min({frames, blockSize, getFramesToScheduled()});
+    renderBlock(blockFrames);
+    frames -= blockFrames;
+    renderedFrames += blockFrames;
+  }
+}
+
+void AudioEngine::pushCommand(Command& command) {
+  if(offline) {
+    handleCommand(command);
+    return;
+  }
+  const bool parameter = isParameterCommand(command);
+  const bool query = command.response != nullptr;
+  if(queuePolicy == QueuePolicy::OverwriteLatest && !query && overflowPending) {
+    // while some parameters wait aside, all new commands wait with them, so nothing overtakes them in queue
+    pushOverflow(command);
+    return;
+  }
+
+  // counted before push, so engine can't handle command before it's counted
+  auto count = [&command](auto f) {
+    forEachState(command, f);
+    for(auto& batched : command.batch) {
+      forEachState(batched, f);
+    }
+  };
+  count([](PublishedState& state) {
+    state.commandPushed();
+  });
+  if(!queue.tryPush(std::move(command))) {
+    // only parameters can be dropped or kept aside, engine must get every other command (missing add or remove would break handles)
+    if(query || queuePolicy == QueuePolicy::Block || !parameter) {
+      queue.waitAndPush(std::move(command));
+    }
+    else {
+      count([](PublishedState& state) {
+        state.commandDropped();
+      });
+      if(queuePolicy == QueuePolicy::Drop) {
+        droppedCommands++;
+      }
+      else {
+        pushOverflow(command);
+      }
+      return;
+    }
+  }
+  if(auto* signal = clockSignal.load()) {
+    signal->notify();
+  }
+}
+
+void AudioEngine::pushOverflow(Command& command) {
+  std::unique_lock lock(overflowMutex);
+  // parameters are coalesced, so only other commands can make overflow grow, they wait for engine like they would for queue
+  while(!isParameterCommand(command) && overflow->size() >= QueueSize) {
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+  }
+  auto pushed = [](PublishedState& state) {
+    state.commandPushed();
+  };
+  if(isParameterCommand(command)) {
+    // command that replaces earlier value of the same parameter was already counted
+    if(!overflow->hasParameter(command)) {
+      forEachState(command, pushed);
+    }
+    overflow->setParameter(std::move(command));
+  }
+  else {
+    forEachState(command, pushed);
+    for(auto& batched : command.batch) {
+      forEachState(batched, pushed);
+    }
+    overflow->add(std::move(command));
+  }
+  overflowPending = true;
+}
+
+void AudioEngine::handleOverflow() {
+  // engine thread doesn't wait for caller that is adding to overflow, it takes commands in next iteration
+  if(!overflowPending || !overflowMutex.try_lock()) {
+    return;
+  }
+  std::swap(overflow, handledOverflow);
+  overflowPending = false;
+  overflowMutex.unlock();
+
+  handledOverflow->compact();
+  for(auto& command : handledOverflow->commands) {
+    handleCommand(command);
+  }
+  handledOverflow->clear();
+}
+
+ParameterValue AudioEngine::pushQuery(Command& command) {
+  if(offline) {
+    return handleQuery(command);
+  }
+  // parameters kept aside were set before query, engine takes them before it gets to query
+  while(overflowPending) {
+    std::this_thread::yield();
+  }
+  ParameterValue response;
+  std::atomic_bool responded{false};
+  command.response = &response;
+  command.responded = &responded;
+  pushCommand(command);
+  while(!responded.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  return response;
 }
 
 void AudioEngine::addMixer(Command& command) {
@@ -509,6 +774,7 @@ void AudioEngine::addMixerOutput(Command& command) {
   auto& output = std::get<OutputHandle>(command.value1);
   outputs[output.id].incrementUseCount();
   mixersOutputs.push_back({mixer, output.id});
+  updateRenderedMixers();
 }
 
 void AudioEngine::removeMixerOutput(Command& command) {
@@ -516,6 +782,7 @@ void AudioEngine::removeMixerOutput(Command& command) {
   auto& output = std::get<OutputHandle>(command.value1);
   outputs[output.id].decrementUseCount();
   mixersOutputs.erase(std::find(mixersOutputs.begin(), mixersOutputs.end(), std::make_pair(mixer, output.id)));
+  updateRenderedMixers();
 }
 
 void AudioEngine::setMixerEffect(Command& command) {
@@ -556,8 +823,18 @@ void AudioEngine::addInput(Command& command) {
 }
 
 void AudioEngine::addOutput(Command& command) {
-  AudioEngineOutput output(std::get<OutputHandle>(command.handle));
-  outputs.insert({std::get<OutputHandle>(command.handle).id, output});
+  auto& handle = std::get<OutputHandle>(command.handle);
+  AudioEngineOutput output(handle);
+  outputs.insert({handle.id, output});
+
+  // first output driven by device becomes clock of engine, frames pending from real time clock are dropped
+  if(!clock && !offline) {
+    clock = handle.get().getRenderSignal();
+    clockSignal = clock.get();
+    if(clock) {
+      pendingFrames = 0;
+    }
+  }
 }
 
 void AudioEngine::setEffectParameter(Command& command) {
@@ -576,27 +853,87 @@ void AudioEngine::setMultiEffectParameter(Command& command) {
   std::get<EffectHandle>(command.handle).ptr->setParameter(command.ind1, command.ind2, std::get<ParameterValue>(command.value1));
 }
 
-void AudioEngine::askIsPlaying(Command& command) {
-  outQueue.tryPush(ParameterValue::boolean(std::get<InputHandle>(command.handle).get().isPlaying() && (!inputs[std::get<InputHandle>(command.handle).id].notUsed())));
+ParameterValue AudioEngine::askIsPlaying(Command& command) {
+  // operator[] would add empty input, that play would later find instead of the real one
+  auto& handle = std::get<InputHandle>(command.handle);
+  auto it = inputs.find(handle.id);
+  return ParameterValue::boolean(handle.get().isPlaying() && it != inputs.end() && !it->second.notUsed());
+}
+
+ParameterValue AudioEngine::getAudioInputOutputValue(Command& command) {
+  return std::get<InputHandle>(command.handle).get().getOutputValue(command.ind1);
 }
 
-void AudioEngine::getAudioInputOutputValue(Command& command) {
-  outQueue.tryPush(std::get<InputHandle>(command.handle).get().getOutputValue(command.ind1));
+ParameterValue AudioEngine::getAudioOutputOutputValue(Command& command) {
+  return std::get<OutputHandle>(command.handle).get().getOutputValue(command.ind1);
 }
 
-void AudioEngine::getAudioOutputOutputValue(Command& command) {
-  outQueue.tryPush(std::get<OutputHandle>(command.handle).get().getOutputValue(command.ind1));
+ParameterValue AudioEngine::getEffectOutputValue(Command& command) {
+  return std::get<EffectHandle>(command.handle).get().getOutputValue(command.ind1);
 }
 
-void AudioEngine::getEffectOutputValue(Command& command) {
-  outQueue.tryPush(std::get<EffectHandle>(command.handle).get().getOutputValue(command.ind1));
+ParameterValue AudioEngine::askHasEnded(Command& command) {
+  return ParameterValue::boolean(std::get<OutputHandle>(command.handle).get().ended());
 }
 
-void AudioEngine::askHasEnded(Command& command) {
-  outQueue.tryPush(ParameterValue::boolean(std::get<OutputHandle>(command.handle).get().ended()));
+template<typename F>
+void AudioEngine::forEachState(Command& command, F&& function) {
+  auto visitor = [&function](auto& value) {
+    if constexpr(requires { value.state; }) {
+      if(value.state) {
+        function(*value.state);
+      }
+    }
+  };
+  std::visit(visitor, command.handle);
+  std::visit(visitor, command.value1);
+  std::visit(visitor, command.value2);
+}
+
+bool AudioEngine::isParameterCommand(const Command& command) {
+  switch(command.type) {
+    case Command::Type::SetEffectParameter:
+    case Command::Type::SetMultiEffectParameter:
+    case Command::Type::SetInputParameter:
+    case Command::Type::SetOutputParameter:
+      return true;
+
+    default:
+      return false;
+  }
 }
 
 void AudioEngine::handleCommand(Command& command) {
+  // scheduled command counts as handled, state published before its frame is already its result
+  forEachState(command, [](PublishedState& state) {
+    state.commandHandled();
+  });
+  if(command.frame > renderedFrames) {
+    // commands for the same frame run in order they came
+    auto it = std::lower_bound(scheduled.begin(), scheduled.end(), command.frame, [](const Command& c, uint64_t frame) {
+      return c.frame > frame;
+    });
+    scheduled.insert(it, std::move(command));
+    return;
+  }
+  runCommand(command);
+}
+
+void AudioEngine::runScheduledCommands() {
+  while(!scheduled.empty() && scheduled.back().frame <= renderedFrames) {
+    runCommand(scheduled.back());
+    scheduled.pop_back();
+  }
+}
+
+size_t AudioEngine::getFramesToScheduled() const {
+  if(scheduled.empty()) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return scheduled.back().frame - renderedFrames;
+}
+
+void AudioEngine::runCommand(Command& command) {
   switch(command.type) {
     case Command::Type::AddEffect:
       addEffect(command);
@@ -650,73 +987,436 @@ void AudioEngine::handleCommand(Command& command) {
       setMultiEffectParameter(command);
       break;
 
-    case Command::Type::AskIsPlaying:
-      askIsPlaying(command);
+    case Command::Type::Batch:
+      for(auto& batched : command.batch) {
+        handleCommand(batched);
+      }
       break;
 
+    case Command::Type::AskIsPlaying:
     case Command::Type::GetAudioInputOutputValue:
-      getAudioInputOutputValue(command);
+    case Command::Type::GetAudioOutputOutputValue:
+    case Command::Type::GetEffectOutputValue:
+    case Command::Type::AskHasEnded:
+      *command.response = handleQuery(command);
+      command.responded->store(true, std::memory_order_release);
       break;
 
+    default:
+      assert(false);
+  }
+}
+
+ParameterValue AudioEngine::handleQuery(Command& command) {
+  switch(command.type) {
+    case Command::Type::AskIsPlaying:
+      return askIsPlaying(command);
+
+    case Command::Type::GetAudioInputOutputValue:
+      return getAudioInputOutputValue(command);
+
     case Command::Type::GetAudioOutputOutputValue:
-      getAudioInputOutputValue(command);
-      break;
+      return getAudioOutputOutputValue(command);
 
     case Command::Type::GetEffectOutputValue:
-      getAudioInputOutputValue(command);
-      break;
+      return getEffectOutputValue(command);
+
+    case Command::Type::AskHasEnded:
+      return askHasEnded(command);
 
     default:
       assert(false);
+      return ParameterValue();
+  }
+}
+
+
+void AudioEngine::updateRenderedMixers() {
+  renderedMixers.clear();
+  for(auto& p : mixersOutputs) {
+    Mixer* mixer = p.first.ptr.get();
+    auto rendered = std::find_if(renderedMixers.begin(), renderedMixers.end(), [&](const RenderedMixer& r) { return r.mixer == mixer; });
+    if(rendered == renderedMixers.end()) {
+      renderedMixers.push_back({mixer, AudioBlock(blockSize)});
+    }
+  }
+}
+
+template<class F>
+void AudioEngine::groupRendered(size_t count, F key) {
+  renderedGroups.clear();
+  for(size_t i = 0; i < count; i++) {
+    if(i == 0 || key(i) != key(i - 1)) {
+      renderedGroups.push_back(i);
+    }
+  }
+  renderedGroups.push_back(count);
+}
+
+void AudioEngine::renderBlock(size_t frames) {
+  renderedMixerInputs.clear();
+  for(auto& rendered : renderedMixers) {
+    for(size_t i = 0; i < rendered.mixer->getNumberOfInputs(); i++) {
+      renderedMixerInputs.push_back({rendered.mixer, i});
+    }
+  }
+
+  // inputs can be shared between mixers, so all of them are read before mixers start using them
+  for(auto& input : inputs) {
+    input.second.resetCached();
+  }
+  renderedInputs.clear();
+  for(auto& [mixer, i] : renderedMixerInputs) {
+    AudioEngineInput* input = &mixer->getInput(i);
+    if(std::find(renderedInputs.begin(), renderedInputs.end(), input) == renderedInputs.end()) {
+      renderedInputs.push_back(input);
+    }
+  }
+  workers.parallelFor(renderedInputs.size(), [&](size_t i) {
+    renderedInputs[i]->get(frames);
+  });
+
+  // effects are not thread safe, so inputs sharing an effect are processed in one task
+  std::stable_sort(renderedMixerInputs.begin(), renderedMixerInputs.end(), [](const auto& a, const auto& b) {
+    return std::less<const Effect*>()(a.first->getInputEffect(a.second), b.first->getInputEffect(b.second));
+  });
+  groupRendered(renderedMixerInputs.size(), [&](size_t i) { return renderedMixerInputs[i].first->getInputEffect(renderedMixerInputs[i].second); });
+  workers.parallelFor(renderedGroups.size() - 1, [&](size_t group) {
+    for(size_t i = renderedGroups[group]; i < renderedGroups[group + 1]; i++) {
+      renderedMixerInputs[i].first->processInput(renderedMixerInputs[i].second, frames);
+    }
+  });
+
+  // mixers sharing mixer effect or tail effect are joined into one task
+  auto findGroup = [&](size_t i) {
+    while(mixerGroupParent[i] != i) {
+      i = mixerGroupParent[i] = mixerGroupParent[mixerGroupParent[i]];
+    }
+    return i;
+  };
+  mixerGroupParent.resize(renderedMixers.size());
+  mixEffects.clear();
+  for(size_t i = 0; i < renderedMixers.size(); i++) {
+    mixerGroupParent[i] = i;
+    mixerEffects.clear();
+    renderedMixers[i].mixer->getMixEffects(mixerEffects);
+    for(auto effect : mixerEffects) {
+      mixEffects.push_back({effect, i});
+    }
+  }
+  std::sort(mixEffects.begin(), mixEffects.end(), [](const auto& a, const auto& b) { return std::less<const Effect*>()(a.first, b.first); });
+  for(size_t i = 1; i < mixEffects.size(); i++) {
+    if(mixEffects[i].first == mixEffects[i - 1].first) {
+      mixerGroupParent[findGroup(mixEffects[i].second)] = findGroup(mixEffects[i - 1].second);
+    }
+  }
+  renderedMixerOrder.resize(renderedMixers.size());
+  for(size_t i = 0; i < renderedMixers.size(); i++) {
+    renderedMixerOrder[i] = i;
+  }
+  std::stable_sort(renderedMixerOrder.begin(), renderedMixerOrder.end(), [&](size_t a, size_t b) { return findGroup(a) < findGroup(b); });
+  groupRendered(renderedMixerOrder.size(), [&](size_t i) { return findGroup(renderedMixerOrder[i]); });
+  workers.parallelFor(renderedGroups.size() - 1, [&](size_t group) {
+    for(size_t i = renderedGroups[group]; i < renderedGroups[group + 1]; i++) {
+      auto& rendered = renderedMixers[renderedMixerOrder[i]];
+      rendered.mixer->mix(rendered.block.getView(rendered.mixer->getFormat(), frames), frames);
+    }
+  });
+
+  for(auto& rendered : renderedMixers) {
+    rendered.mixer->removeEnded();
+    if(rendered.mixer->errorOccured()) {
+      error = true;
+    }
+  }
+
+  for(auto& p : mixersOutputs) {
+    auto& rendered = *std::find_if(renderedMixers.begin(), renderedMixers.end(), [&](const RenderedMixer& r) { return r.mixer == p.first.ptr.get(); });
+    auto& output = outputs[p.second];
+    const FrameFormat outputFormat = output.getOutput().get().getFormat();
+
+    auto mixerView = rendered.block.getView(rendered.mixer->getFormat(), frames);
+    auto outputView = outputBlock.getView(outputFormat, frames);
+    Tools::convertBlock(mixerView, rendered.mixer->getFormat(), outputView, outputFormat, frames);
+    output.send(outputView, frames);
+    if(output.getOutput().get().errorOccured()) {
+      error = true;
+    }
+  }
+
+  for(auto& output : outputs) {
+    output.second.finishedBlock(frames);
+  }
+}
+
+void AudioEngine::removeUnusedInputs() {
+  for(auto it = inputs.begin(); it != inputs.end();) {
+    if(it->second.getUseCount() == 0) {
+      it->second.getHandle().state->unpublish();
+      it = inputs.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void AudioEngine::publishState() {
+  for(auto& [id, input] : inputs) {
+    auto& handle = input.getHandle();
+    handle.state->publish(input.isPlaying() && !input.notUsed(), false, [&handle](size_t valueID) {
+      return handle.get().getOutputValue(valueID);
+    });
+  }
+  for(auto& [id, output] : outputs) {
+    auto& handle = output.getOutput();
+    handle.state->publish(false, handle.get().ended(), [&handle](size_t valueID) {
+      return handle.get().getOutputValue(valueID);
+    });
+  }
+  for(auto& effect : effects) {
+    effect.state->publish(false, false, [&effect](size_t valueID) {
+      return effect.get().getOutputValue(valueID);
+    });
   }
 }
 
+size_t AudioEngine::waitForFrames() {
+  if(auto* signal = clockSignal.load()) {
+    return signal->wait();
+  }
+
+  // no output is driven by device, so render in real time
+  const std::chrono::duration<double> renderedTime(renderedFrames / sampleRate.Hz());
+  std::this_thread::sleep_until(clockStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(renderedTime));
+  return blockSize;
+}
 
 void AudioEngine::engineThread() {
   while(!ready) {
     std::this_thread::yield();
   }
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame1;
-  std::array<sample_t, Tools::MaxNumberOfChannels> frame2;
+  clockStart = std::chrono::steady_clock::now();
 
   while(run) {
+    if(pendingFrames == 0) {
+      pendingFrames = waitForFrames();
+    }
+
     while(auto command = queue.tryPop()) {
       handleCommand(*command);
     }
-    std::fill(frame1.begin(), frame1.end(), 0.);
-    std::fill(frame2.begin(), frame2.end(), 0.);
+    handleOverflow();
 
-    for(auto& input : inputs) {
-      input.second.resetCached();
-    }
+    runScheduledCommands();
+    removeUnusedInputs();
 
-    for(auto it = inputs.begin(); it != inputs.end();) {
-      if(it->second.getUseCount() == 0) {
-        it = inputs.erase(it);
-      }
-      else {
-        ++it;
-      }
+    // block is split at frame of the next scheduled command
+    const size_t frames = std::min({pendingFrames, blockSize, getFramesToScheduled()});
+    if(frames) {
+      renderBlock(frames);
+      pendingFrames -= frames;
+      renderedFrames += frames;
     }
+    publishState();
+  }
+}
 
+// AudioEngine::CommandBatch--------------------------------------------------------------------------------
 
-    for(auto& p : mixersOutputs) {
-      p.first.ptr->get(frame1);
-      if(p.first.ptr->errorOccured()) {
-        error = true;
-      }
-      Tools::convertFrames(frame1, p.first.ptr->getFormat(), frame2, outputs[p.second].getOutput().get().getFormat());
-      outputs[p.second].send(frame2);
-      if(outputs[p.second].getOutput().get().errorOccured()) {
-        error = true;
-      }
-    }
+void AudioEngine::CommandBatch::addMixerOutput(const MixerHandle& mixer, const OutputHandle& output) {
+  if(!mixer || !output) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::AddMixerOutput;
+  command.handle = mixer;
+  command.value1 = output;
+  add(std::move(command));
+}
+
+void AudioEngine::CommandBatch::removeMixerOutput(const MixerHandle& mixer, const OutputHandle& output) {
+  if(!mixer || !output) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::RemoveMixerOutput;
+  command.handle = mixer;
+  command.value1 = output;
+  add(std::move(command));
+}
+
+void AudioEngine::CommandBatch::setMixerEffect(const MixerHandle& mixer, const EffectHandle& effect) {
+  if(!mixer || !effect) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::SetMixerEffect;
+  command.handle = mixer;
+  command.value1 = effect;
+  add(std::move(command));
+}
+
+void AudioEngine::CommandBatch::play(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect) {
+  playAt(mixer, input, effect, 0);
+}
+
+void AudioEngine::CommandBatch::play(const MixerHandle& mixer, const InputHandle& input) {
+  playAt(mixer, input, 0);
+}
+
+void AudioEngine::CommandBatch::stop(const MixerHandle& mixer, const InputHandle& input) {
+  stopAt(mixer, input, 0);
+}
+
+void AudioEngine::CommandBatch::playAt(const MixerHandle& mixer, const InputHandle& input, const EffectHandle& effect, uint64_t frame) {
+  if(!mixer || !input || !effect) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::Play;
+  command.handle = mixer;
+  command.value1 = input;
+  command.value2 = effect;
+  command.frame = frame;
+  add(std::move(command));
+}
+
+void AudioEngine::CommandBatch::playAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame) {
+  if(!mixer || !input) {
+    return;
+  }
+  playAt(mixer, input, EffectHandle(std::make_shared<BypassEffect>(input.get().getFormat(), mixer.get().getFormat())), frame);
+}
+
+void AudioEngine::CommandBatch::stopAt(const MixerHandle& mixer, const InputHandle& input, uint64_t frame) {
+  if(!mixer || !input) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::Stop;
+  command.handle = mixer;
+  command.value1 = input;
+  command.frame = frame;
+  add(std::move(command));
+}
+
+void AudioEngine::CommandBatch::setEffectParameter(const EffectHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame) {
+  if(!handle) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::SetEffectParameter;
+  command.handle = handle;
+  command.ind1 = parameterID;
+  command.value1 = v;
+  command.frame = frame;
+  setParameter(std::move(command));
+}
+
+void AudioEngine::CommandBatch::setMultiEffectParameter(const EffectHandle& handle, size_t effectID, size_t parameterID, const ParameterValue& v, uint64_t frame) {
+  if(!handle) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::SetMultiEffectParameter;
+  command.handle = handle;
+  command.ind1 = effectID;
+  command.ind2 = parameterID;
+  command.value1 = v;
+  command.frame = frame;
+  setParameter(std::move(command));
+}
+
+void AudioEngine::CommandBatch::setInputParameter(const InputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame) {
+  if(!handle) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::SetInputParameter;
+  command.handle = handle;
+  command.ind1 = parameterID;
+  command.value1 = v;
+  command.frame = frame;
+  setParameter(std::move(command));
+}
 
-    for(auto& output : outputs) {
-      output.second.finishedFrame();
+void AudioEngine::CommandBatch::setOutputParameter(const OutputHandle& handle, size_t parameterID, const ParameterValue& v, uint64_t frame) {
+  if(!handle) {
+    return;
+  }
+  Command command;
+  command.type = Command::Type::SetOutputParameter;
+  command.handle = handle;
+  command.ind1 = parameterID;
+  command.value1 = v;
+  command.frame = frame;
+  setParameter(std::move(command));
+}
+
+size_t AudioEngine::CommandBatch::size() const {
+  return commands.size() - droppedCommands;
+}
+
+bool AudioEngine::CommandBatch::empty() const {
+  return size() == 0;
+}
+
+void AudioEngine::CommandBatch::clear() {
+  commands.clear();
+  dropped.clear();
+  droppedCommands = 0;
+  parameters.clear();
+}
+
+AudioEngine::CommandBatch::ParameterKey AudioEngine::CommandBatch::getParameterKey(const Command& command) {
+  const void* target = std::visit([](const auto& handle) -> const void* { return handle.ptr.get(); }, command.handle);
+  return ParameterKey(command.type, target, command.ind1, command.ind2, command.frame);
+}
+
+bool AudioEngine::CommandBatch::hasParameter(const Command& command) const {
+  return parameters.contains(getParameterKey(command));
+}
+
+void AudioEngine::CommandBatch::add(Command command) {
+  commands.push_back(std::move(command));
+  dropped.push_back(false);
+}
+
+void AudioEngine::CommandBatch::setParameter(Command command) {
+  // whole batch is handled between two blocks, so earlier value for the same frame would never be heard
+  // it's dropped instead of overwritten, so the last value keeps its order with other commands
+  const ParameterKey key = getParameterKey(command);
+  if(auto it = parameters.find(key); it != parameters.end()) {
+    dropped[it->second] = true;
+    droppedCommands++;
+  }
+  parameters[key] = commands.size();
+  add(std::move(command));
+  if(droppedCommands > commands.size() / 2) {
+    compact();
+  }
+}
+
+void AudioEngine::CommandBatch::compact() {
+  parameters.clear();
+  size_t kept = 0;
+  for(size_t i = 0; i < commands.size(); i++) {
+    if(dropped[i]) {
+      continue;
+    }
+    if(kept != i) {
+      commands[kept] = std::move(commands[i]);
+    }
+    if(isParameterCommand(commands[kept])) {
+      parameters[getParameterKey(commands[kept])] = kept;
     }
+    kept++;
   }
+  commands.resize(kept);
+  dropped.assign(kept, false);
+  droppedCommands = 0;
 }
 
 
-} // namespace ZAudio
+} // namespace ZAudio
\ No newline at end of file
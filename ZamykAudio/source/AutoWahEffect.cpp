@@ -14,9 +14,13 @@ AutoWahEffect::Parameters::Parameters(Volume lowEnvelope_p, Volume highEnvelope_
 
 void AutoWahEffect::process(std::span<const sample_t> in, std::span<sample_t> out) {  
   Volume env = detector.process(in[0]);  
-  env = std::clamp(env, parameters.lowEnvelope, parameters.highEnvelope);  
-  currFrequency = Frequency::Hz(NormalizedValue(parameters.lowEnvelope.dB(), parameters.highEnvelope.dB(), env.dB()).bind(parameters.minFrequency.Hz(), parameters.maxFrequency.Hz()));  
-  updateFilter();
+  if(controlCounter == 0) {
+    env = std::clamp(env, parameters.lowEnvelope, parameters.highEnvelope);  
+    currFrequency = Frequency::Hz(NormalizedValue(parameters.lowEnvelope.dB(), parameters.highEnvelope.dB(), env.dB()).bind(parameters.minFrequency.Hz(), parameters.maxFrequency.Hz()));  
+    updateFilter();
+    controlCounter = Tools::AnalogFilter::ControlInterval;
+  }
+  controlCounter--;
   out[0] = bandPass.process(in[0]);
 }
 
@@ -24,6 +28,7 @@ void AutoWahEffect::setSampleRate(Frequency sampleRate_p) {
   sampleRate = sampleRate_p;
   detector = Tools::AudioDetector(sampleRate, Tools::AudioDetector::DetectMode::MeanSquare, parameters.decay, parameters.decay, true);      
   currFrequency = parameters.minFrequency;  
+  bandPass.reset(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, currFrequency, parameters.q));
 }
 
 void AutoWahEffect::setParameter(size_t id, ParameterValue value) {
@@ -54,7 +59,7 @@ void AutoWahEffect::setParameter(size_t id, ParameterValue value) {
 }
 
 void AutoWahEffect::updateFilter() {
-  bandPass.reset(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, currFrequency, parameters.q));
+  bandPass.rampTo(Tools::AnalogFilter::Coefficients::create(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, currFrequency, parameters.q)), Tools::AnalogFilter::ControlInterval);
 }
 
 uint32_t AutoWahEffect::getTailTime() const {
@@ -1,5 +1,7 @@
 #include <ZAudio/BufferDecoder.h>
 
+#include <algorithm>
+
 namespace ZAudio {
 
 
@@ -7,16 +9,28 @@ BufferDecoder::BufferDecoder(SoundBuffer&& buffer_p) : buffer(std::make_shared<S
 
 BufferDecoder::BufferDecoder(std::shared_ptr<const SoundBuffer> buffer_p) : buffer(buffer_p) {}
 
-bool BufferDecoder::get(std::span<sample_t> out) {
-  if(looped && position >= buffer->getLoopEnd()) {
-    seek(buffer->getLoopStart());
+size_t BufferDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  const size_t channels = buffer->getNumberOfChannels();
+  size_t done = 0;
+  while(done < frames) {
+    if(looped && position >= buffer->getLoopEnd()) {
+      seek(buffer->getLoopStart());
+    }
+    const uint64_t end = looped ? buffer->getLoopEnd() : buffer->getLength();
+    if(position >= end) {
+      break;
+    }
+    const size_t n = std::min<uint64_t>(frames - done, end - position);
+    for(size_t c = 0; c < channels; c++) {
+      auto samples = buffer->getChannel(c).subspan(position, n);
+      for(size_t i = 0; i < n; i++) {
+        interleaved[(done + i) * channels + c] = samples[i];
+      }
+    }
+    position += n;
+    done += n;
   }
-  else if(position >= buffer->getLength()) {
-    return false;
-  }  
-  buffer->getFrame(position, out.begin());
-  position++;
-  return true;
+  return done;
 }
 
 void BufferDecoder::seek(uint64_t position_p) {
@@ -10,6 +10,10 @@ void BypassEffect::process(std::span<const sample_t> in, std::span<sample_t> out
   Tools::convertFrames(in, inputFormat, out, outputFormat);
 }
 
+void BypassEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  Tools::convertBlock(in, inputFormat, out, outputFormat, frames);
+}
+
 uint32_t BypassEffect::getTailTime() const {
   return 0;
 }
@@ -51,26 +51,19 @@ void CallbackInput::get(std::span<sample_t> out) {
     ind = 0;
   }
     
-  while(!sampleRateConverters.front().outReady()) {      
+  while(!resampler.outReady()) {      
     if(ind == buffer.size()) {
       break;
     }
-    for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-      sampleRateConverters[i].push(buffer[ind]);
-      ind++;
-    }
+    resampler.push(std::span<const sample_t>(buffer).subspan(ind, resampler.getNumberOfChannels()));
+    ind += resampler.getNumberOfChannels();
   }
 
-  for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-    out[i] = sampleRateConverters[i].get();
-  }
+  resampler.get(out);
 }
 
 void CallbackInput::setSampleRate(Frequency sampleRate) {
-  sampleRateConverters.resize(Tools::numberOfChannels(format));
-  for(auto& converter : sampleRateConverters) {
-    converter = Tools::SampleRateConverter(inSampleRate, sampleRate);
-  }
+  resampler = Tools::Resampler(Tools::numberOfChannels(format), inSampleRate, sampleRate);
 }
 
 void CallbackInput::setParameter(size_t id, ParameterValue value) {}
@@ -100,11 +93,9 @@ void CallbackOutput::send(std::span<const sample_t> in) {
   if(callbackData->ended) {
     return;
   }
-  for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-    sampleRateConverters[i].push(in[i]);
-  }
+  resampler.push(in);
 
-  while(sampleRateConverters[0].outReady()) {                  
+  while(resampler.outReady()) {                  
     if(ind == buffer.size()) {
       if(blocking) {
         while(!callbackData->bufferEmpty && !callbackData->ended) {          
@@ -124,18 +115,14 @@ void CallbackOutput::send(std::span<const sample_t> in) {
       callbackData->bufferEmpty = false;
     }
 
-    for(size_t i = 0; i < sampleRateConverters.size(); i++) {
-      buffer[ind] = sampleRateConverters[i].get();
-      ind++;
-    }
+    resampler.get(std::span<sample_t>(buffer).subspan(ind, resampler.getNumberOfChannels()));
+    ind += resampler.getNumberOfChannels();
   }    
 }
 
-void CallbackOutput::setSampleRate(Frequency sampleRate) {
-  sampleRateConverters.resize(Tools::numberOfChannels(format));
-  for(auto& converter : sampleRateConverters) {
-    converter = Tools::SampleRateConverter(sampleRate, outSampleRate);
-  }
+void CallbackOutput::setSampleRate(Frequency sampleRate_p) {
+  sampleRate = sampleRate_p;
+  resampler = Tools::Resampler(Tools::numberOfChannels(format), sampleRate, outSampleRate);
 }
 
 void CallbackOutput::setParameter(size_t id, ParameterValue value) {}
@@ -152,5 +139,14 @@ FrameFormat CallbackOutput::getFormat() const {
   return format;
 }
 
+std::shared_ptr<ThreadTools::RenderSignal> CallbackOutput::getRenderSignal() {
+  auto& renderSignal = callbackData->renderSignal;
+  renderSignal.setRatio(sampleRate.Hz() / outSampleRate.Hz());
+  renderSignal.clear();
+  // two buffers ahead, one for callback and one being filled
+  renderSignal.requestFrames(2 * buffer.size() / Tools::numberOfChannels(format));
+  return std::shared_ptr<ThreadTools::RenderSignal>(callbackData, &renderSignal);
+}
+
 
 } // namespace ZAudio
\ No newline at end of file
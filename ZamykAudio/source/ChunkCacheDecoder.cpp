@@ -0,0 +1,142 @@
+#include <ZAudio/ChunkCacheDecoder.h>
+
+#include <algorithm>
+
+namespace ZAudio {
+
+
+// DecodedChunkCache---------------------------------------------------------------------------------------------
+
+DecodedChunkCache::DecodedChunkCache(size_t maxChunks_p) : maxChunks(maxChunks_p) {}
+
+std::shared_ptr<const std::vector<sample_t>> DecodedChunkCache::get(uint32_t sound, uint64_t chunk) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find({sound, chunk});
+  if(it == index.end()) {
+    return nullptr;
+  }
+  entries.splice(entries.begin(), entries, it->second);
+  return it->second->samples;
+}
+
+void DecodedChunkCache::put(uint32_t sound, uint64_t chunk, std::shared_ptr<const std::vector<sample_t>> samples) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if(maxChunks == 0 || index.contains({sound, chunk})) {
+    return;
+  }
+  if(entries.size() == maxChunks) {
+    index.erase(entries.back().key);
+    entries.pop_back();
+  }
+  entries.push_front(Entry{{sound, chunk}, std::move(samples)});
+  index.insert({{sound, chunk}, entries.begin()});
+}
+
+size_t DecodedChunkCache::size() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+// ChunkCacheDecoder---------------------------------------------------------------------------------------------
+
+ChunkCacheDecoder::ChunkCacheDecoder(std::unique_ptr<AudioDecoder> decoder_p, uint32_t sound_p, std::shared_ptr<DecodedChunkCache> cache_p) :
+  decoder(std::move(decoder_p)),
+  sound(sound_p),
+  cache(std::move(cache_p)),
+  numberOfChannels(Tools::numberOfChannels(decoder->getFormat())),
+  length(decoder->getLength()),
+  loopStart(decoder->getLoopStart()),
+  loopEnd(decoder->getLoopEnd())
+{
+  // looping is done here, decoder is only read forward by chunks
+  decoder->setLooped(false);
+}
+
+size_t ChunkCacheDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  size_t done = 0;
+  while(done < frames && !error) {
+    if(looped && position >= loopEnd) {
+      seek(loopStart);
+    }
+    const uint64_t end = looped ? loopEnd : length;
+    if(position >= end) {
+      break;
+    }
+
+    const uint64_t index = position / DecodedChunkCache::ChunkLength;
+    if(!chunk || index != chunkIndex) {
+      loadChunk(index);
+    }
+    const uint64_t offset = position - index * DecodedChunkCache::ChunkLength;
+    const size_t n = std::min<uint64_t>({frames - done, end - position, chunk->size() / numberOfChannels - offset});
+    if(n == 0) {
+      break;
+    }
+    std::copy_n(chunk->begin() + offset * numberOfChannels, n * numberOfChannels, interleaved.begin() + done * numberOfChannels);
+    position += n;
+    done += n;
+  }
+  return done;
+}
+
+void ChunkCacheDecoder::loadChunk(uint64_t index) {
+  chunkIndex = index;
+  chunk = cache->get(sound, index);
+  if(chunk) {
+    return;
+  }
+
+  const uint64_t begin = index * DecodedChunkCache::ChunkLength;
+  const uint64_t frames = std::min<uint64_t>(DecodedChunkCache::ChunkLength, length - begin);
+  if(decoder->getPosition() != begin) {
+    decoder->seek(begin);
+  }
+  auto samples = std::make_shared<std::vector<sample_t>>(frames * numberOfChannels, 0.);
+  if(decoder->read(*samples, frames) < frames) {
+    error = decoder->errorOccured();
+  }
+  // chunk that wasn't decoded whole isn't shared
+  if(!error) {
+    cache->put(sound, index, samples);
+  }
+  chunk = std::move(samples);
+}
+
+void ChunkCacheDecoder::seek(uint64_t position_p) {
+  position = position_p;
+}
+
+uint64_t ChunkCacheDecoder::getLength() {
+  return length;
+}
+
+Frequency ChunkCacheDecoder::getSampleRate() {
+  return decoder->getSampleRate();
+}
+
+uint64_t ChunkCacheDecoder::getPosition() {
+  return position;
+}
+
+uint64_t ChunkCacheDecoder::getLoopStart() {
+  return loopStart;
+}
+
+uint64_t ChunkCacheDecoder::getLoopEnd() {
+  return loopEnd;
+}
+
+void ChunkCacheDecoder::setLooped(bool looped_p) {
+  looped = looped_p;
+}
+
+bool ChunkCacheDecoder::errorOccured() const {
+  return error;
+}
+
+FrameFormat ChunkCacheDecoder::getFormat() const {
+  return decoder->getFormat();
+}
+
+
+} // namespace ZAudio
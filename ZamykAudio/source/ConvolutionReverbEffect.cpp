@@ -0,0 +1,431 @@
+#include <ZAudio/ConvolutionReverbEffect.h>
+#include <ZAudio/SampleRateConversion.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace ZAudio::Tools {
+
+
+// BackgroundConvolution------------------------------------------------------------------------------------
+
+BackgroundConvolution::BackgroundConvolution(const std::vector<std::vector<double>>& impulses) {
+  size_t maxLength = 0;
+  for(const auto& impulse : impulses) {
+    maxLength = std::max(maxLength, impulse.size());
+  }
+#ifdef ZAUDIO_USE_FFT
+  // taps before 2 * TailPartitionSize are in head, so thread has whole partition of time to compute its result
+  const bool useThread = maxLength > 2 * TailPartitionSize;
+#else
+  const bool useThread = false;
+  (void)maxLength;
+#endif
+
+  for(const auto& impulse : impulses) {
+    const size_t headLength = useThread ? std::min(impulse.size(), 2 * TailPartitionSize) : impulse.size();
+    heads.emplace_back(std::vector<double>(impulse.begin(), impulse.begin() + headLength));
+    if(useThread) {
+      // PartitionedConvolution skips its first partition, so starting one partition before the tail leaves it out
+      std::span<const double> tail(impulse);
+      tails.emplace_back(impulse.size() > 2 * TailPartitionSize ? tail.subspan(TailPartitionSize) : std::span<const double>(), TailPartitionSize);
+    }
+  }
+
+  if(useThread) {
+    tailInputs.resize(impulses.size(), std::vector<sample_t>(TailPartitionSize, 0.));
+    tailOutputs = threadInputs = threadOutputs = tailInputs;
+    silence.resize(TailPartitionSize, 0.);
+    thread = std::thread([this]() {
+      threadFunction();
+    });
+  }
+}
+
+BackgroundConvolution::~BackgroundConvolution() {
+  if(thread.joinable()) {
+    // thread only waits for busy, so it's woken up by setting it after the last partition is done
+    busy.wait(true, std::memory_order_acquire);
+    stop = true;
+    busy.store(true, std::memory_order_release);
+    busy.notify_one();
+    thread.join();
+  }
+}
+
+void BackgroundConvolution::process(std::span<const sample_t> in, std::span<sample_t> out) {
+  assert(in.size() == heads.size() && out.size() == heads.size());
+  for(size_t i = 0; i < heads.size(); i++) {
+    out[i] = heads[i].process(in[i]);
+  }
+  if(tails.empty()) {
+    return;
+  }
+
+  for(size_t i = 0; i < tails.size(); i++) {
+    out[i] += tailOutputs[i][position];
+    tailInputs[i][position] = in[i];
+  }
+  if(++position == TailPartitionSize) {
+    exchangeWithThread();
+    position = 0;
+  }
+}
+
+void BackgroundConvolution::process(std::span<const std::span<const sample_t>> in, std::span<const std::span<sample_t>> out) {
+  assert(in.size() == heads.size() && out.size() == heads.size());
+  const size_t frames = in.empty() ? 0 : in[0].size();
+  size_t done = 0;
+  while(done < frames) {
+    // whole run up to the partition boundary goes through head and tail at once
+    const size_t length = tails.empty() ? frames - done : std::min(frames - done, TailPartitionSize - position);
+    for(size_t i = 0; i < heads.size(); i++) {
+      auto runIn = in[i].subspan(done, length);
+      auto runOut = out[i].subspan(done, length);
+      heads[i].process(runIn, runOut);
+      if(!tails.empty()) {
+        std::copy(runIn.begin(), runIn.end(), tailInputs[i].begin() + position);
+        for(size_t j = 0; j < length; j++) {
+          runOut[j] += tailOutputs[i][position + j];
+        }
+      }
+    }
+    done += length;
+    if(!tails.empty()) {
+      position += length;
+      if(position == TailPartitionSize) {
+        exchangeWithThread();
+        position = 0;
+      }
+    }
+  }
+}
+
+size_t BackgroundConvolution::getNumberOfConvolutions() const {
+  return heads.size();
+}
+
+void BackgroundConvolution::setRealTime(bool realTime_p) {
+  realTime = realTime_p;
+}
+
+size_t BackgroundConvolution::getUnderruns() const {
+  return underruns;
+}
+
+void BackgroundConvolution::exchangeWithThread() {
+  // no lock is taken in audio thread, thread had whole partition of time, so busy is normally already false
+  // in real time late thread is not waited for, in offline render (faster than real time) it is
+  if(realTime && busy.load(std::memory_order_acquire)) {
+    underruns++;
+    skippedPartitions++;
+    discardThreadOutput = true;
+    for(auto& output : tailOutputs) {
+      std::fill(output.begin(), output.end(), 0.);
+    }
+    return;
+  }
+  busy.wait(true, std::memory_order_acquire);
+  // finished output is needed for next partition, filled input goes to thread
+  std::swap(tailOutputs, threadOutputs);
+  std::swap(tailInputs, threadInputs);
+  if(discardThreadOutput) {
+    discardThreadOutput = false;
+    for(auto& output : tailOutputs) {
+      std::fill(output.begin(), output.end(), 0.);
+    }
+  }
+  threadSkippedPartitions = skippedPartitions;
+  skippedPartitions = 0;
+  busy.store(true, std::memory_order_release);
+  busy.notify_one();
+}
+
+void BackgroundConvolution::threadFunction() {
+  while(true) {
+    busy.wait(false, std::memory_order_acquire);
+    if(stop) {
+      return;
+    }
+    for(size_t i = 0; i < tails.size(); i++) {
+      // lost partitions keep later input aligned with impulse
+      for(size_t j = 0; j < threadSkippedPartitions; j++) {
+        tails[i].processPartition(silence, threadOutputs[i]);
+      }
+      tails[i].processPartition(threadInputs[i], threadOutputs[i]);
+    }
+    busy.store(false, std::memory_order_release);
+    busy.notify_one();
+  }
+}
+
+
+} // namespace ZAudio::Tools
+
+namespace ZAudio {
+
+
+ConvolutionReverbEffect::Parameters::Parameters(const std::string& impulsePath_p, FrameFormat format_p, Volume wet_p, Volume dry_p, const std::string& rightImpulsePath_p) :
+  impulsePath(impulsePath_p),
+  rightImpulsePath(rightImpulsePath_p),
+  format(format_p),
+  wet(wet_p),
+  dry(dry_p) {}
+
+ConvolutionReverbEffect::ConvolutionReverbEffect(Parameters parameters_p) : parameters(parameters_p) {
+  assert(parameters.format == FrameFormat::Mono || parameters.format == FrameFormat::Stereo);
+}
+
+Result ConvolutionReverbEffect::loadImpulses(SoundCache& cache) {
+  auto loadImpulse = [&cache](const std::string& path) -> ResultValue<std::shared_ptr<const SoundBuffer>> {
+    auto id = cache.add(path);
+    if(!id) {
+      return Result::error(cache.getError());
+    }
+    return cache.getBuffer(*id);
+  };
+
+  auto loadedImpulse = loadImpulse(parameters.impulsePath);
+  if(!loadedImpulse) {
+    return Result::error(loadedImpulse.getDescription());
+  }
+  std::shared_ptr<const SoundBuffer> loadedRightImpulse;
+  if(!parameters.rightImpulsePath.empty()) {
+    auto res = loadImpulse(parameters.rightImpulsePath);
+    if(!res) {
+      return Result::error(res.getDescription());
+    }
+    loadedRightImpulse = res.get();
+  }
+  return setImpulses(loadedImpulse.get(), loadedRightImpulse);
+}
+
+Result ConvolutionReverbEffect::setImpulses(std::shared_ptr<const SoundBuffer> impulse_p, std::shared_ptr<const SoundBuffer> rightImpulse_p) {
+#ifndef ZAUDIO_USE_FFT
+  // length at sample rate of effect, if it's not set yet, at sample rate of impulse
+  auto tooLong = [this](const std::shared_ptr<const SoundBuffer>& buffer) {
+    if(!buffer) {
+      return false;
+    }
+    const double ratio = sampleRate.Hz() > 0. ? sampleRate.Hz() / buffer->getSampleRate().Hz() : 1.;
+    return buffer->getLength() * ratio > MaxImpulseLengthWithoutFFT;
+  };
+  if(tooLong(impulse_p) || tooLong(rightImpulse_p)) {
+    return Result::error("Impulse is longer than " + std::to_string(MaxImpulseLengthWithoutFFT) + " samples, longer impulses require ZAUDIO_ENABLE_FFT");
+  }
+#endif
+  impulse = std::move(impulse_p);
+  rightImpulse = std::move(rightImpulse_p);
+  prepareConvolution();
+  return Result::success();
+}
+
+FrameFormat ConvolutionReverbEffect::getOutputFormat() const {
+  return parameters.format;
+}
+
+FrameFormat ConvolutionReverbEffect::getInputFormat() const {
+  return parameters.format;
+}
+
+void ConvolutionReverbEffect::process(std::span<const sample_t> in, std::span<sample_t> out) {
+  const size_t channels = Tools::numberOfChannels(parameters.format);
+  if(!convolution) {
+    for(size_t i = 0; i < channels; i++) {
+      out[i] = in[i] * parameters.dry.linear();
+    }
+    return;
+  }
+
+  if(channels == 1) {
+    std::array<sample_t, 1> wet;
+    convolution->process(in.first(1), wet);
+    out[0] = wet[0] * parameters.wet.linear() + in[0] * parameters.dry.linear();
+  }
+  else {
+    // left to left, right to left, left to right, right to right
+    const std::array<sample_t, 4> routes = {in[0], in[1], in[0], in[1]};
+    std::array<sample_t, 4> wet;
+    convolution->process(routes, wet);
+    out[0] = (wet[0] + wet[1]) * parameters.wet.linear() + routes[0] * parameters.dry.linear();
+    out[1] = (wet[2] + wet[3]) * parameters.wet.linear() + routes[1] * parameters.dry.linear();
+  }
+}
+
+void ConvolutionReverbEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  const size_t channels = Tools::numberOfChannels(parameters.format);
+  const double dry = parameters.dry.linear();
+  if(!convolution) {
+    for(size_t channel = 0; channel < channels; channel++) {
+      auto inChannel = in.getChannel(channel);
+      auto outChannel = out.getChannel(channel);
+      for(size_t i = 0; i < frames; i++) {
+        outChannel[i] = inChannel[i] * dry;
+      }
+    }
+    return;
+  }
+
+  // routes are the same as in process, every one gets its own part of wetBlock
+  const size_t routes = convolution->getNumberOfConvolutions();
+  if(wetBlock.size() < routes * frames) {
+    wetBlock.resize(routes * frames);
+  }
+  std::array<std::span<const sample_t>, 4> routeInputs;
+  std::array<std::span<sample_t>, 4> routeOutputs;
+  for(size_t route = 0; route < routes; route++) {
+    routeInputs[route] = in.getChannel(route % channels).first(frames);
+    routeOutputs[route] = std::span<sample_t>(wetBlock).subspan(route * frames, frames);
+  }
+  convolution->process(std::span(routeInputs).first(routes), std::span(routeOutputs).first(routes));
+
+  const double wet = parameters.wet.linear();
+  if(channels == 1) {
+    auto inChannel = in.getChannel(0);
+    auto outChannel = out.getChannel(0);
+    for(size_t i = 0; i < frames; i++) {
+      outChannel[i] = routeOutputs[0][i] * wet + inChannel[i] * dry;
+    }
+  }
+  else {
+    for(size_t channel = 0; channel < 2; channel++) {
+      auto inChannel = in.getChannel(channel);
+      auto outChannel = out.getChannel(channel);
+      auto fromLeft = routeOutputs[2 * channel];
+      auto fromRight = routeOutputs[2 * channel + 1];
+      for(size_t i = 0; i < frames; i++) {
+        outChannel[i] = (fromLeft[i] + fromRight[i]) * wet + inChannel[i] * dry;
+      }
+    }
+  }
+}
+
+void ConvolutionReverbEffect::setParameter(size_t id, ParameterValue value) {
+  switch(id) {
+    case WetID:
+      parameters.wet = value.getVolume();
+      break;
+    case DryID:
+      parameters.dry = value.getVolume();
+      break;
+    default:
+      assert(false);
+  }
+}
+
+void ConvolutionReverbEffect::setSampleRate(Frequency sampleRate_p) {
+  sampleRate = sampleRate_p;
+  prepareConvolution();
+}
+
+void ConvolutionReverbEffect::setRealTime(bool realTime_p) {
+  realTime = realTime_p;
+  if(convolution) {
+    convolution->setRealTime(realTime);
+  }
+}
+
+ParameterValue ConvolutionReverbEffect::getOutputValue(size_t id) {
+  if(id == GetUnderrunsID) {
+    return ParameterValue::integer(convolution ? static_cast<int32_t>(convolution->getUnderruns()) : 0);
+  }
+  return ParameterValue();
+}
+
+uint32_t ConvolutionReverbEffect::getTailTime() const {
+  return tailTime;
+}
+
+void ConvolutionReverbEffect::prepareConvolution() {
+  convolution.reset();
+  tailTime = 0;
+  if(!impulse || sampleRate.Hz() <= 0.) {
+    return;
+  }
+
+  auto resample = [this](const SoundBuffer& buffer) {
+    return buffer.getSampleRate() == sampleRate ? buffer : Tools::convertSampleRateSinc(buffer, sampleRate);
+  };
+  auto getChannel = [](const SoundBuffer& buffer, size_t channel) {
+    auto samples = buffer.getChannel(std::min(channel, buffer.getNumberOfChannels() - 1));
+#ifndef ZAUDIO_USE_FFT
+    // resampling can make accepted impulse a bit longer
+    samples = samples.first(std::min(samples.size(), MaxImpulseLengthWithoutFFT));
+#endif
+    return std::vector<double>(samples.begin(), samples.end());
+  };
+
+  std::vector<std::vector<double>> impulses;
+  const SoundBuffer left = resample(*impulse);
+  if(parameters.format == FrameFormat::Mono) {
+    impulses.push_back(getChannel(left, 0));
+  }
+  else if(rightImpulse) {
+    const SoundBuffer right = resample(*rightImpulse);
+    impulses = {getChannel(left, 0), getChannel(right, 0), getChannel(left, 1), getChannel(right, 1)};
+  }
+  else {
+    impulses = {getChannel(left, 0), getChannel(left, 1), getChannel(left, 1), getChannel(left, 0)};
+  }
+
+  for(const auto& v : impulses) {
+    tailTime = std::max<uint32_t>(tailTime, v.size());
+  }
+  convolution = std::make_unique<Tools::BackgroundConvolution>(impulses);
+  convolution->setRealTime(realTime);
+}
+
+std::unique_ptr<Effect> ConvolutionReverbEffect::clone() const {
+  // convolution owns a thread, so clone prepares its own
+  auto effect = std::make_unique<ConvolutionReverbEffect>(parameters);
+  effect->sampleRate = sampleRate;
+  effect->realTime = realTime;
+  effect->impulse = impulse;
+  effect->rightImpulse = rightImpulse;
+  effect->prepareConvolution();
+  return effect;
+}
+
+static std::string getName(uint32_t v) {
+  const std::array<std::string, ConvolutionReverbEffect::NumOfParameters> names = {
+    "Wet",
+    "Dry"
+  };
+  return names[v];
+}
+
+Result ConvolutionReverbEffect::save(Tools::TreeDatabaseWriter writer) const {
+  Result res = Result::success();
+  res &= writer.addValue("ImpulsePath", parameters.impulsePath);
+  res &= writer.addValue("RightImpulsePath", parameters.rightImpulsePath);
+  res &= writer.addEnumValue<FrameFormat>("Format", parameters.format, frameFormatToString);
+  res &= writer.addValue(getName(WetID), parameters.wet);
+  res &= writer.addValue(getName(DryID), parameters.dry);
+  return res;
+}
+
+Result ConvolutionReverbEffect::load(Tools::TreeDatabaseReader reader) {
+  Result res = Result::success();
+  res &= reader.getValue("ImpulsePath", parameters.impulsePath);
+  res &= reader.getValue("RightImpulsePath", parameters.rightImpulsePath);
+  res &= reader.getEnumValue<FrameFormat>("Format", parameters.format, frameFormatToString);
+  res &= reader.getValue(getName(WetID), parameters.wet);
+  res &= reader.getValue(getName(DryID), parameters.dry);
+  return res;
+}
+
+std::string ConvolutionReverbEffect::getID() const {
+  return "ZA_ConvolutionReverbEffect";
+}
+
+int64_t ConvolutionReverbEffect::getVersion() const {
+  return 1;
+}
+
+ConvolutionReverbEffect::Parameters ConvolutionReverbEffect::getParameters() const {
+  return parameters;
+}
+
+
+} // namespace ZAudio
@@ -11,6 +11,14 @@ void DelayEffect::process(std::span<const sample_t> in, std::span<sample_t> out)
   out[0] = delay.process(in[0]);
 }
 
+void DelayEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  auto inChannel = in.getChannel(0);
+  auto outChannel = out.getChannel(0);
+  for(size_t i = 0; i < frames; i++) {
+    outChannel[i] = delay.process(inChannel[i]);
+  }
+}
+
 void DelayEffect::setParameter(size_t id, ParameterValue value) {
   switch(id) {
     case DelayTimeID:
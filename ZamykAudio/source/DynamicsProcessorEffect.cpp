@@ -18,6 +18,22 @@ void DynamicsProcessorEffect::process(std::span<const sample_t> in, std::span<sa
   }
 }  
 
+void DynamicsProcessorEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  auto inChannel = in.getChannel(0);
+  auto outChannel = out.getChannel(0);
+  const double outputGain = parameters.outputGain.linear();
+  for(size_t i = 0; i < frames; i++) {
+    const sample_t sample = inChannel[i];
+    auto det = detector.process(sample);
+    if( (det > parameters.threshold && parameters.type == Type::Compressor) || (det < parameters.threshold && parameters.type == Type::Expander) ) {
+      outChannel[i] = sample * calculateGainChange(det).linear() * outputGain;
+    }
+    else {
+      outChannel[i] = sample;
+    }
+  }
+}
+
 void DynamicsProcessorEffect::setParameter(size_t id, ParameterValue value) {
   switch(id) {
     case(OutputGainID):
@@ -4,6 +4,7 @@
 #include <ZAudio/AutoWahEffect.h>
 #include <ZAudio/BitCrusherEffect.h>
 #include <ZAudio/BypassEffect.h>
+#include <ZAudio/ConvolutionReverbEffect.h>
 #include <ZAudio/DelayEffect.h>
 #include <ZAudio/DuckDelayEffect.h>
 #include <ZAudio/DynamicsProcessorEffect.h>
@@ -37,6 +38,7 @@ EffectSerializer::EffectSerializer() {
   addEffectType(AutoWahEffect(AutoWahEffect::Parameters()));
   addEffectType(BitCrusherEffect(BitCrusherEffect::Parameters()));
   addEffectType(BypassEffect(FrameFormat::Mono, FrameFormat::Mono));  
+  addEffectType(ConvolutionReverbEffect(ConvolutionReverbEffect::Parameters()));
   addEffectType(DelayEffect(DelayEffect::Parameters()));
   addEffectType(DuckDelayEffect(DuckDelayEffect::Parameters()));
   addEffectType(DynamicsProcessorEffect(DynamicsProcessorEffect::Parameters()));
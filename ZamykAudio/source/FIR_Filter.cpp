@@ -1,10 +1,108 @@
 #include <ZAudio/FIR_Filter.h>
+
+#include <algorithm>
+#include <cassert>
 #include <numbers>
 
 namespace ZAudio::Tools {
 
 
-FIR_Filter::FIR_Filter(const std::vector<double>& coefficients_p) : coefficients(coefficients_p) {}
+// PartitionedConvolution-----------------------------------------------------------------------------------
+
+PartitionedConvolution::PartitionedConvolution(std::span<const double> coefficients, size_t partitionSize_p) :
+  partitionSize(partitionSize_p),
+  accumulator(partitionSize + 1),
+  window(2 * partitionSize, 0.),
+  output(partitionSize, 0.),
+  fft(std::make_unique<FFT>(2 * partitionSize))
+{
+  assert(partitionSize > 0);
+  const size_t fftSize = 2 * partitionSize;
+  for(size_t start = partitionSize; start < coefficients.size(); start += partitionSize) {
+    auto& samples = fft->getSamples();
+    std::fill(samples.begin(), samples.end(), 0.);
+    const size_t length = std::min(partitionSize, coefficients.size() - start);
+    std::copy_n(coefficients.begin() + start, length, samples.begin());
+    fft->doFFT();
+    // FFT normalizes bins, impulse spectra are stored unnormalized so product of spectra has correct scale after inverse FFT
+    auto& partition = partitions.emplace_back(partitionSize + 1);
+    for(size_t i = 0; i <= partitionSize; i++) {
+      partition[i] = fft->getBins()[i] * static_cast<double>(fftSize);
+    }
+  }
+  inputSpectra.resize(partitions.size(), std::vector<std::complex<double>>(partitionSize + 1));
+}
+
+PartitionedConvolution::PartitionedConvolution(const PartitionedConvolution& oth) :
+  partitionSize(oth.partitionSize),
+  partitions(oth.partitions),
+  inputSpectra(oth.inputSpectra),
+  newestSpectrum(oth.newestSpectrum),
+  accumulator(oth.accumulator),
+  window(oth.window),
+  output(oth.output),
+  position(oth.position),
+  fft(oth.fft ? std::make_unique<FFT>(2 * partitionSize) : nullptr) {}
+
+PartitionedConvolution& PartitionedConvolution::operator= (const PartitionedConvolution& oth) {
+  if(this != &oth) {
+    *this = PartitionedConvolution(oth);
+  }
+  return *this;
+}
+
+void PartitionedConvolution::processPartition(std::span<const sample_t> in, std::span<sample_t> out) {
+  assert(in.size() == partitionSize && out.size() == partitionSize && position == 0);
+  std::copy(in.begin(), in.end(), window.begin() + partitionSize);
+  processWindow(out);
+}
+
+size_t PartitionedConvolution::getPartitionSize() const {
+  return partitionSize;
+}
+
+void PartitionedConvolution::processWindow(std::span<sample_t> out) {
+  const size_t fftSize = 2 * partitionSize;
+  if(partitions.empty()) {
+    std::fill(out.begin(), out.end(), 0.);
+    return;
+  }
+
+  auto& samples = fft->getSamples();
+  std::copy(window.begin(), window.end(), samples.begin());
+  fft->doFFT();
+  newestSpectrum = newestSpectrum + 1 == inputSpectra.size() ? 0 : newestSpectrum + 1;
+  auto& bins = fft->getBins();
+  std::copy_n(bins.begin(), partitionSize + 1, inputSpectra[newestSpectrum].begin());
+
+  // next output partition is sum of every impulse partition k >= 1 convolved with input from k partitions before
+  std::fill(accumulator.begin(), accumulator.end(), 0.);
+  size_t spectrum = newestSpectrum;
+  for(const auto& partition : partitions) {
+    const auto& input = inputSpectra[spectrum];
+    for(size_t i = 0; i <= partitionSize; i++) {
+      accumulator[i] += input[i] * partition[i];
+    }
+    spectrum = spectrum == 0 ? inputSpectra.size() - 1 : spectrum - 1;
+  }
+
+  // input is real so spectrum is symmetric, only first half was computed
+  for(size_t i = 0; i <= partitionSize; i++) {
+    bins[i] = accumulator[i];
+  }
+  for(size_t i = 1; i < partitionSize; i++) {
+    bins[fftSize - i] = std::conj(accumulator[i]);
+  }
+  fft->doInverseFFT();
+  std::copy_n(samples.begin() + partitionSize, partitionSize, out.begin());
+  std::copy_n(window.begin() + partitionSize, partitionSize, window.begin());
+}
+
+// FIR_Filter-----------------------------------------------------------------------------------------------
+
+FIR_Filter::FIR_Filter(const std::vector<double>& coefficients_p) : coefficients(coefficients_p) {
+  prepare();
+}
 
 FIR_Filter FIR_Filter::sincFilter(Frequency sampleRate, Frequency cutOffFrequency, uint32_t windowSize, WindowFunction::Type windowFunctionType) {
   if(windowSize % 2 == 0) {
@@ -13,7 +111,6 @@ FIR_Filter FIR_Filter::sincFilter(Frequency sampleRate, Frequency cutOffFrequenc
 
   FIR_Filter filter;
   filter.coefficients.resize(windowSize);
-  filter.buffer.resize(windowSize);
   WindowFunction::calculateWindow(windowFunctionType, filter.coefficients);
 
   const double fc = cutOffFrequency.Hz() / sampleRate.Hz();
@@ -32,19 +129,54 @@ FIR_Filter FIR_Filter::sincFilter(Frequency sampleRate, Frequency cutOffFrequenc
   for(auto& v : filter.coefficients) {
     v *= gainCorrection;
   }
+  filter.prepare();
 
   return filter;    
 }
 
 sample_t FIR_Filter::process(sample_t in) {
-  buffer.push(in);
+  if(directLength == 0) {
+    return 0.;
+  }
+  historyPosition = historyPosition == 0 ? directLength - 1 : historyPosition - 1;
+  history[historyPosition] = in;
+  history[historyPosition + directLength] = in;
+
+  // history[historyPosition + i] is input from i samples ago
+  const sample_t* past = history.data() + historyPosition;
   sample_t out = 0.;
-  for(size_t i = 0; i < coefficients.size(); i++) {
-    out += coefficients[i] * buffer.get(i);
+  for(size_t i = 0; i < directLength; i++) {
+    out += coefficients[i] * past[i];
+  }
+  if(convolution) {
+    out += convolution->process(in);
   }
   return out;
 }
 
+void FIR_Filter::process(std::span<const sample_t> in, std::span<sample_t> out) {
+  assert(in.size() == out.size());
+  for(size_t i = 0; i < in.size(); i++) {
+    out[i] = process(in[i]);
+  }
+}
+
+bool FIR_Filter::usesFFT() const {
+  return convolution.has_value();
+}
+
+void FIR_Filter::prepare() {
+  directLength = coefficients.size();
+#ifdef ZAUDIO_USE_FFT
+  if(coefficients.size() > FFTThreshold) {
+    directLength = PartitionSize;
+    convolution.emplace(coefficients, PartitionSize);
+  }
+#endif
+  history.assign(2 * directLength, 0.);
+  historyPosition = 0;
+}
+
 
 
 } // namespace ZAudio::Tools
\ No newline at end of file
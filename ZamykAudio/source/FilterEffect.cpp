@@ -15,6 +15,10 @@ void FilterEffect::process(std::span<const sample_t> in, std::span<sample_t> out
   out[0] = filter.process(in[0]);
 }
 
+void FilterEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  filter.process(in.getChannel(0).first(frames), out.getChannel(0).first(frames));
+}
+
 void FilterEffect::setParameter(size_t id, ParameterValue value) {
   switch(id) {
     case TypeID:
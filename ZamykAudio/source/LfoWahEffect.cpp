@@ -11,8 +11,12 @@ LfoWahEffect::Parameters::Parameters(Frequency rate_p, Frequency minFrequency_p,
 LfoWahEffect::LfoWahEffect(Parameters parameters_p) : parameters(parameters_p) {}
 
 void LfoWahEffect::process(std::span<const sample_t> in, std::span<sample_t> out) {
-  currFrequency = Frequency::Hz(lfo.get().bind(parameters.minFrequency.Hz(), parameters.maxFrequency.Hz()));
-  updateFilter();
+  if(controlCounter == 0) {
+    currFrequency = Frequency::Hz(lfo.get().bind(parameters.minFrequency.Hz(), parameters.maxFrequency.Hz()));
+    updateFilter();
+    controlCounter = Tools::AnalogFilter::ControlInterval;
+  }
+  controlCounter--;
   out[0] = bandPass.process(in[0]);
 }
 
@@ -39,12 +43,14 @@ uint32_t LfoWahEffect::getTailTime() const {
 
 void LfoWahEffect::setSampleRate(Frequency sampleRate_p) {
   sampleRate = sampleRate_p;  
-  lfo = Tools::LowFrequencyOscillator(sampleRate, parameters.rate, Tools::LowFrequencyOscillator::ShapeType::Sine);
-  currFrequency = parameters.minFrequency;  
+  lfo = Tools::LowFrequencyOscillator(Frequency::Hz(sampleRate.Hz() / Tools::AnalogFilter::ControlInterval), parameters.rate, Tools::LowFrequencyOscillator::ShapeType::Sine);
+  currFrequency = Frequency::Hz(lfo.get().bind(parameters.minFrequency.Hz(), parameters.maxFrequency.Hz()));
+  bandPass.reset(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, currFrequency, 2));
+  controlCounter = 1;
 }
 
 void LfoWahEffect::updateFilter() {
-  bandPass.reset(ZAudio::Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, currFrequency, 2));
+  bandPass.rampTo(Tools::AnalogFilter::Coefficients::create(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, currFrequency, 2)), Tools::AnalogFilter::ControlInterval);
 }
 
 std::unique_ptr<Effect> LfoWahEffect::clone() const {
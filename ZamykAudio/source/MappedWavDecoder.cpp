@@ -0,0 +1,324 @@
+#include <ZAudio/MappedWavDecoder.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#ifdef _WIN32
+// min and max macros would break std::min below
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ZAudio {
+
+
+// MappedFile---------------------------------------------------------------------------------------------------
+
+ResultValue<std::shared_ptr<const MappedFile>> MappedFile::open(const std::filesystem::path& path) {
+  Result res;
+  auto ans = std::make_shared<const MappedFile>(path, res);
+  if(!res) {
+    return res;
+  }
+  return ans;
+}
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path, Result& result) {
+  result = Result::error("Couldn't map file " + path.string());
+  file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE) {
+    file = nullptr;
+    return;
+  }
+  LARGE_INTEGER fileSize;
+  if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    return;
+  }
+  mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(!mapping) {
+    return;
+  }
+  data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if(!data) {
+    return;
+  }
+  size = fileSize.QuadPart;
+  result = Result::success();
+}
+
+MappedFile::~MappedFile() {
+  if(data) {
+    UnmapViewOfFile(data);
+  }
+  if(mapping) {
+    CloseHandle(mapping);
+  }
+  if(file) {
+    CloseHandle(file);
+  }
+}
+
+void MappedFile::advise(size_t, size_t, Advice) const {}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path, Result& result) {
+  result = Result::error("Couldn't map file " + path.string());
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if(file == -1) {
+    return;
+  }
+  struct stat info;
+  if(fstat(file, &info) == 0 && info.st_size > 0) {
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+    if(mapped != MAP_FAILED) {
+      data = static_cast<const uint8_t*>(mapped);
+      size = info.st_size;
+      result = Result::success();
+    }
+  }
+  // mapping stays valid after file is closed
+  close(file);
+}
+
+MappedFile::~MappedFile() {
+  if(data) {
+    munmap(const_cast<uint8_t*>(data), size);
+  }
+}
+
+void MappedFile::advise(size_t offset, size_t length, Advice advice) const {
+  offset = std::min(offset, size);
+  length = std::min(length, size - offset);
+  if(length == 0) {
+    return;
+  }
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  const size_t begin = offset / pageSize * pageSize;
+  madvise(const_cast<uint8_t*>(data) + begin, offset + length - begin, advice == Advice::Sequential ? MADV_SEQUENTIAL : MADV_WILLNEED);
+}
+
+#endif
+
+std::span<const uint8_t> MappedFile::getData() const {
+  return {data, size};
+}
+
+// MappedWavDecoder---------------------------------------------------------------------------------------------
+
+namespace {
+
+// wav is little endian on every platform
+uint32_t readLittleEndian(const uint8_t* bytes, size_t count) {
+  uint32_t v = 0;
+  for(size_t i = 0; i < count; i++) {
+    v |= uint32_t(bytes[i]) << (8 * i);
+  }
+  return v;
+}
+
+template<typename Convert>
+void convertSamples(const uint8_t* in, size_t bytesPerSample, std::span<sample_t> out, Convert convert) {
+  for(size_t i = 0; i < out.size(); i++) {
+    out[i] = convert(in + i * bytesPerSample);
+  }
+}
+
+} // namespace
+
+ResultValue<std::unique_ptr<AudioDecoder>> MappedWavDecoder::load(const std::filesystem::path& path) {
+  auto file = MappedFile::open(path);
+  if(!file) {
+    return Result::error(file.getDescription());
+  }
+  Result res;
+  auto ans = std::make_unique<MappedWavDecoder>(std::move(file.get()), res);
+  if(!res) {
+    return res;
+  }
+  return static_cast<std::unique_ptr<AudioDecoder>>(std::move(ans));
+}
+
+MappedWavDecoder::MappedWavDecoder(std::shared_ptr<const MappedFile> file_p, Result& result) : file(std::move(file_p)) {
+  result = parseHeader();
+  if(result) {
+    const size_t dataOffset = samples.data() - file->getData().data();
+    file->advise(dataOffset, samples.size(), MappedFile::Advice::Sequential);
+    readAhead();
+  }
+}
+
+Result MappedWavDecoder::parseHeader() {
+  const auto data = file->getData();
+  if(data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+    return Result::error("Not a wav file");
+  }
+
+  uint32_t formatTag = 0;
+  uint32_t bitsPerSample = 0;
+  bool gotFormat = false;
+  size_t offset = 12;
+  while(offset + 8 <= data.size()) {
+    const uint8_t* chunk = data.data() + offset;
+    const size_t chunkSize = std::min<size_t>(readLittleEndian(chunk + 4, 4), data.size() - offset - 8);
+    if(std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16) {
+      formatTag = readLittleEndian(chunk + 8, 2);
+      numberOfChannels = readLittleEndian(chunk + 10, 2);
+      sampleRate = Frequency::Hz(readLittleEndian(chunk + 12, 4));
+      bitsPerSample = readLittleEndian(chunk + 22, 2);
+      // WAVE_FORMAT_EXTENSIBLE has real format at the beginning of sub format guid
+      if(formatTag == 0xFFFE && chunkSize >= 40) {
+        formatTag = readLittleEndian(chunk + 32, 2);
+      }
+      gotFormat = true;
+    }
+    else if(std::memcmp(chunk, "data", 4) == 0) {
+      samples = data.subspan(offset + 8, chunkSize);
+      break;
+    }
+    // chunks are aligned to 2 bytes
+    offset += 8 + chunkSize + (chunkSize & 1);
+  }
+  if(!gotFormat || samples.data() == nullptr) {
+    return Result::error("Wav file without format or data");
+  }
+
+  if(formatTag == 1 && bitsPerSample == 8) {
+    encoding = Encoding::UInt8;
+  }
+  else if(formatTag == 1 && bitsPerSample == 16) {
+    encoding = Encoding::Int16;
+  }
+  else if(formatTag == 1 && bitsPerSample == 24) {
+    encoding = Encoding::Int24;
+  }
+  else if(formatTag == 1 && bitsPerSample == 32) {
+    encoding = Encoding::Int32;
+  }
+  else if(formatTag == 3 && bitsPerSample == 32) {
+    encoding = Encoding::Float32;
+  }
+  else if(formatTag == 3 && bitsPerSample == 64) {
+    encoding = Encoding::Float64;
+  }
+  else {
+    return Result::error("Unsupported wav format " + std::to_string(formatTag) + " with " + std::to_string(bitsPerSample) + " bits per sample");
+  }
+
+  if(numberOfChannels == 1) {
+    format = FrameFormat::Mono;
+  }
+  else if(numberOfChannels == 2) {
+    format = FrameFormat::Stereo;
+  }
+  else {
+    return Result::error("as for now, only mono and stereo :(, number of channels: " + std::to_string(numberOfChannels));
+  }
+  bytesPerSample = bitsPerSample / 8;
+  // truncated file has shorter data than its header says
+  length = samples.size() / (bytesPerSample * numberOfChannels);
+  return Result::success();
+}
+
+size_t MappedWavDecoder::read(std::span<sample_t> interleaved, size_t frames) {
+  size_t done = 0;
+  while(done < frames) {
+    if(position >= length) {
+      if(!looped || length == 0) {
+        break;
+      }
+      seek(0);
+    }
+    const size_t n = std::min<uint64_t>(frames - done, length - position);
+    const uint8_t* in = samples.data() + position * numberOfChannels * bytesPerSample;
+    auto out = interleaved.subspan(done * numberOfChannels, n * numberOfChannels);
+    switch(encoding) {
+      case Encoding::UInt8:
+        convertSamples(in, 1, out, [](const uint8_t* p) {
+          return sample_t((int(*p) - 128) / 128.);
+        });
+        break;
+      case Encoding::Int16:
+        convertSamples(in, 2, out, [](const uint8_t* p) {
+          return sample_t(int16_t(readLittleEndian(p, 2)) / 32768.);
+        });
+        break;
+      case Encoding::Int24:
+        convertSamples(in, 3, out, [](const uint8_t* p) {
+          // sample is moved to top bytes of int32_t, so its sign is kept
+          return sample_t(int32_t(readLittleEndian(p, 3) << 8) / 2147483648.);
+        });
+        break;
+      case Encoding::Int32:
+        convertSamples(in, 4, out, [](const uint8_t* p) {
+          return sample_t(int32_t(readLittleEndian(p, 4)) / 2147483648.);
+        });
+        break;
+      case Encoding::Float32:
+        convertSamples(in, 4, out, [](const uint8_t* p) {
+          return sample_t(std::bit_cast<float>(readLittleEndian(p, 4)));
+        });
+        break;
+      case Encoding::Float64:
+        convertSamples(in, 8, out, [](const uint8_t* p) {
+          const uint64_t bits = readLittleEndian(p, 4) | (uint64_t(readLittleEndian(p + 4, 4)) << 32);
+          return sample_t(std::bit_cast<double>(bits));
+        });
+        break;
+    }
+    position += n;
+    done += n;
+  }
+  return done;
+}
+
+void MappedWavDecoder::seek(uint64_t position_p) {
+  position = std::min(position_p, length);
+  readAhead();
+}
+
+void MappedWavDecoder::readAhead() {
+  const size_t frameSize = numberOfChannels * bytesPerSample;
+  const size_t dataOffset = samples.data() - file->getData().data();
+  file->advise(dataOffset + position * frameSize, ReadAheadSeconds * sampleRate.Hz() * frameSize, MappedFile::Advice::WillNeed);
+}
+
+void MappedWavDecoder::setLooped(bool looped_p) {
+  looped = looped_p;
+}
+
+uint64_t MappedWavDecoder::getLength() {
+  return length;
+}
+
+Frequency MappedWavDecoder::getSampleRate() {
+  return sampleRate;
+}
+
+uint64_t MappedWavDecoder::getPosition() {
+  return position;
+}
+
+bool MappedWavDecoder::errorOccured() const {
+  return false;
+}
+
+FrameFormat MappedWavDecoder::getFormat() const {
+  return format;
+}
+
+
+} // namespace ZAudio
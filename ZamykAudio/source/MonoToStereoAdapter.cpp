@@ -39,6 +39,11 @@ void MonoToStereoAdapter::setSampleRate(Frequency sampleRate) {
   right->setSampleRate(sampleRate);
 }
 
+void MonoToStereoAdapter::setRealTime(bool realTime) {
+  left->setRealTime(realTime);
+  right->setRealTime(realTime);
+}
+
 std::unique_ptr<Effect> MonoToStereoAdapter::clone() const {
   if(left == nullptr) {
     return std::make_unique<MonoToStereoAdapter>();
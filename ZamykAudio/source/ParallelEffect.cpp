@@ -29,6 +29,7 @@ void ParallelEffect::setEffect(size_t i, std::unique_ptr<Effect> effect) {
   if(sampleRateSet) {
     effects[i]->setSampleRate(sampleRate);
   }
+  effects[i]->setRealTime(realTime);
 }
 
 void ParallelEffect::process(std::span<const sample_t> in, std::span<sample_t> out) {
@@ -50,6 +51,35 @@ void ParallelEffect::process(std::span<const sample_t> in, std::span<sample_t> o
   }
 }
 
+void ParallelEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  block1.reserve(frames);
+  block2.reserve(frames);
+  sumBlock.reserve(frames);
+
+  auto sum = sumBlock.getView(outputFormat, frames);
+  sum.clear();
+
+  for(auto& effect : effects) {
+    auto effectIn = block1.getView(effect->getInputFormat(), frames);
+    auto effectOut = block2.getView(effect->getOutputFormat(), frames);
+    Tools::convertBlock(in, inputFormat, effectIn, effect->getInputFormat(), frames);
+    effect->processBlock(effectIn, effectOut, frames);
+
+    auto converted = block1.getView(outputFormat, frames);
+    Tools::convertBlock(effectOut, effect->getOutputFormat(), converted, outputFormat, frames);
+
+    for(size_t channel = 0; channel < sum.getNumberOfChannels(); channel++) {
+      auto sumChannel = sum.getChannel(channel);
+      auto convertedChannel = converted.getChannel(channel);
+      for(size_t i = 0; i < frames; i++) {
+        sumChannel[i] += convertedChannel[i] / static_cast<double>(effects.size());
+      }
+    }
+  }
+
+  Tools::convertBlock(sum, outputFormat, out, outputFormat, frames);
+}
+
 void ParallelEffect::setParameter(size_t id, ParameterValue value) {}
 
 void ParallelEffect::setSampleRate(Frequency sampleRate_p) {
@@ -60,6 +90,13 @@ void ParallelEffect::setSampleRate(Frequency sampleRate_p) {
   }
 }
 
+void ParallelEffect::setRealTime(bool realTime_p) {
+  realTime = realTime_p;
+  for(auto& effect : effects) {
+    effect->setRealTime(realTime);
+  }
+}
+
 void ParallelEffect::setParameter(size_t effectID, size_t id, ParameterValue value) {
   effects[effectID]->setParameter(id, value);
 }
@@ -6,7 +6,11 @@ namespace ZAudio::Tools {
 PhaseShifter::PhaseShifter(Frequency sampleRate_p, double depth_p, Frequency rate_p, double phaseOffset_p) : 
   sampleRate(sampleRate_p),
   depth(depth_p),
-  lfo(sampleRate, rate_p, ZAudio::Tools::LowFrequencyOscillator::ShapeType::Sine, phaseOffset_p) {}
+  lfo(Frequency::Hz(sampleRate.Hz() / AnalogFilter::ControlInterval), rate_p, ZAudio::Tools::LowFrequencyOscillator::ShapeType::Sine, phaseOffset_p) {
+  // coefficients of first sample are set directly, from second sample filters ramp to next control point
+  updateFilters(0);
+  controlCounter = 1;
+}
 
 void PhaseShifter::setDepth(double depth_p) {
   depth = depth_p;  
@@ -17,21 +21,25 @@ void PhaseShifter::setRate(Frequency rate_p) {
 }
 
 sample_t PhaseShifter::process(sample_t in) {
+  if(controlCounter == 0) {
+    updateFilters(AnalogFilter::ControlInterval);
+    controlCounter = AnalogFilter::ControlInterval;
+  }
+  controlCounter--;
+  return filters.processCascade(in);
+}
+
+void PhaseShifter::updateFilters(size_t frames) {
   auto lfoV = lfo.get();
   AnalogFilter::Parameters parameters;
   parameters.sampleRate = sampleRate;
   parameters.type = AnalogFilter::Type::AllPass;
+  std::array<AnalogFilter::Coefficients, NumOfFilters> targets;
   for(size_t i = 0; i < NumOfFilters; i++) {    
     parameters.frequency = Frequency::Hz(lfoV.bindFromLeft(minFrequencies[i].Hz(), maxFrequencies[i].Hz(), depth));
-    filters[i].reset(parameters);
+    targets[i] = AnalogFilter::Coefficients::create(parameters);
   } 
-
-  sample_t out = in;
-  for(size_t i = 0; i < NumOfFilters; i++) {
-    out = filters[i].process(out);
-  }
-
-  return out;
+  filters.rampTo(targets, frames);
 }
 
 
@@ -1,8 +1,16 @@
 #include <ZAudio/SampleRateConversion.h>
 #include <ZAudio/Math.h>
 
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <numbers>
+#include <optional>
+#include <tuple>
 
 
 namespace ZAudio::Tools {
@@ -48,67 +56,113 @@ SoundBuffer convertSampleRateLinear(const SoundBuffer& in, Frequency outSampleRa
   return out;
 }
 
-static sample_t get(std::span<const sample_t> in, const SincLookup& lookup, int32_t radius, double position) {
-  sample_t ans = 0.;
-  int32_t index = std::floor(position);
-  double fract = position - index;
-
-  for(int32_t d = 0; d <= std::min(radius, index); d++) {
-    int32_t i = index - d;
-    sample_t x = 0.;
-    //if(i >= 0 && i < static_cast<int32_t>(in.getLength())) {
-      x = in[i];
-    //}
-    ans += x * lookup.get(d, fract);
+// independent sums let compiler use vector instructions
+static double dotProduct(const double* coefficients, const sample_t* samples, size_t size) {
+  std::array<double, 4> sums = {0., 0., 0., 0.};
+  size_t i = 0;
+  for(; i + sums.size() <= size; i += sums.size()) {
+    for(size_t j = 0; j < sums.size(); j++) {
+      sums[j] += coefficients[i + j] * samples[i + j];
+    }
+  }
+  for(; i < size; i++) {
+    sums[0] += coefficients[i] * samples[i];
   }
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
 
-  fract = 1. - fract;
+namespace {
 
-  for(int32_t d = 0; d < std::min(radius, static_cast<int32_t>(in.size()) - index - 1); d++) {
-    int32_t i = index + 1 + d;
-    sample_t x = 0.;
-    //if(i >= 0 && i < static_cast<int32_t>(in.getLength())) {
-      x = in[i];
-    //}
-    ans += x * lookup.get(d, fract);
+// kernels of SincLookup for every sub sample phase, output between two phases is interpolated from dot products with both of them
+class SincKernels {
+public:
+  SincKernels(const SincLookup& lookup, int32_t radius_p) : radius(radius_p), overSample(lookup.getOverSample()) {
+    for(uint32_t phase = 0; phase <= overSample; phase++) {
+      kernels.push_back(lookup.getKernel(phase, radius));
+    }
   }
 
-  return ans;
-}
+  sample_t get(std::span<const sample_t> in, double position) const {
+    const int64_t index = static_cast<int64_t>(position);
+    const double scaled = (position - index) * overSample;
+    const uint32_t phase = std::min(static_cast<uint32_t>(scaled), overSample - 1);
+    const double fract = scaled - phase;
+
+    // kernel[i] is for input index - radius + i, inputs outside of in are zeros
+    const int64_t first = std::max<int64_t>(0, radius - index);
+    const int64_t last = std::min<int64_t>(2 * radius + 1, static_cast<int64_t>(in.size()) - index + radius);
+    if(last <= first) {
+      return 0.;
+    }
+    const sample_t* samples = in.data() + (index - radius + first);
+    const double a = dotProduct(kernels[phase].data() + first, samples, last - first);
+    const double b = dotProduct(kernels[phase + 1].data() + first, samples, last - first);
+    return a + fract * (b - a);
+  }
 
-SoundBuffer convertSampleRateSinc(const SoundBuffer& in, Frequency outSampleRate, int32_t filterRadius, std::atomic_bool* interrupt) {
+private:
+  int64_t radius;
+  uint32_t overSample;
+  std::vector<std::vector<double>> kernels;
+};
+
+} // namespace
+
+SoundBuffer convertSampleRateSinc(const SoundBuffer& in, Frequency outSampleRate, int32_t filterRadius, std::atomic_bool* interrupt,
+                                  ThreadTools::WorkerPool* pool, const SampleRateConversion::ProgressFunction& progress) {
   if(in.getSampleRate() == outSampleRate) {
     return in;
   }
   const double ratio = (outSampleRate / in.getSampleRate());
   SoundBuffer out(outSampleRate, in.getFrameFormat(), in.getLength() * ratio, in.getLoopStart() * ratio, in.getLoopEnd() * ratio);
   SincLookup lookup(in.getSampleRate(), std::min(in.getSampleRate(), outSampleRate) / 2., filterRadius + 2, 4, WindowFunction::Type::Blackman);
+  const SincKernels kernels(lookup, filterRadius);
 
   const double step = in.getSampleRate() / outSampleRate;
-  for(size_t channel = 0; channel < out.getNumberOfChannels(); channel++) {
-    double position = 0.;
+  const size_t chunks = (out.getLength() + SampleRateConversion::ChunkLength - 1) / SampleRateConversion::ChunkLength;
+  const size_t tasks = chunks * out.getNumberOfChannels();
+  std::mutex progressMutex;
+  size_t finished = 0;
+
+  auto convertChunk = [&](size_t task) {
+    const size_t channel = task / chunks;
+    const size_t begin = (task % chunks) * SampleRateConversion::ChunkLength;
     auto inSamples = in.getChannel(channel);
-    auto outSamples = out.getChannel(channel);
+    auto outSamples = out.getChannel(channel).subspan(begin, std::min(SampleRateConversion::ChunkLength, out.getLength() - begin));
     for(size_t i = 0; i < outSamples.size(); i++) {
       static constexpr size_t CheckInterruptPeriod = 256;
       if(interrupt != nullptr && i % CheckInterruptPeriod == 0) {
         if(*interrupt) {
-          return out;
+          return;
         }
       }
-      //out.setSample(i, channel, get(in, channel, lookup, filterRadius, position));
-      outSamples[i] = get(inSamples, lookup, filterRadius, position);
-      position += step;
+      // position is computed from index, so chunks don't depend on each other
+      outSamples[i] = kernels.get(inSamples, (begin + i) * step);
+    }
+    if(progress) {
+      std::lock_guard<std::mutex> lock(progressMutex);
+      finished++;
+      progress(static_cast<double>(finished) / tasks);
+    }
+  };
+
+  if(pool != nullptr) {
+    pool->parallelFor(tasks, convertChunk);
+  }
+  else {
+    for(size_t task = 0; task < tasks; task++) {
+      convertChunk(task);
     }
   }
   return out;
 }
 
-SoundBuffer changeTempo(const SoundBuffer& in, double tempo, int32_t filterRadius, std::atomic_bool* interrupt) {
+SoundBuffer changeTempo(const SoundBuffer& in, double tempo, int32_t filterRadius, std::atomic_bool* interrupt,
+                        ThreadTools::WorkerPool* pool, const SampleRateConversion::ProgressFunction& progress) {
   if(tempo == 1.) {
     return in;
   }
-  auto tmp = ZAudio::Tools::convertSampleRateSinc(in, in.getSampleRate() / tempo, filterRadius, interrupt);
+  auto tmp = ZAudio::Tools::convertSampleRateSinc(in, in.getSampleRate() / tempo, filterRadius, interrupt, pool, progress);
   tmp.setSampleRate(in.getSampleRate());
   return tmp;
 }
@@ -134,8 +188,8 @@ SincLookup::SincLookup(Frequency sampleRate, Frequency cutOffFrequency, uint32_t
     sum += coefficients[i];
   }
 
-  // 0.5 - its only half of filter
-  const double normalizationFactor = 0.5 * overSample / sum;
+  // whole filter is both halves with shared middle coefficient
+  const double normalizationFactor = overSample / (2. * sum - coefficients[0]);
   for(auto& v : coefficients) {
     v *= normalizationFactor;
   }
@@ -148,6 +202,21 @@ double SincLookup::get(uint32_t index, double fract) const {
   return Math::linearInterpolation(coefficients[index], coefficients[index + 1], fract);
 }
 
+std::vector<double> SincLookup::getKernel(uint32_t phase, uint32_t radius) const {
+  assert(phase <= overSample && (radius + 1) * overSample < coefficients.size());
+  std::vector<double> kernel(2 * radius + 1);
+  for(size_t i = 0; i < kernel.size(); i++) {
+    // distance of input from position in oversampled steps
+    const int64_t distance = (static_cast<int64_t>(i) - static_cast<int64_t>(radius)) * overSample - phase;
+    kernel[i] = coefficients[std::abs(distance)];
+  }
+  return kernel;
+}
+
+uint32_t SincLookup::getOverSample() const {
+  return overSample;
+}
+
 // SincFilter-------------------------------------------------------------------------------
 
 static size_t nextOdd(size_t i) {
@@ -182,45 +251,243 @@ sample_t SincFilter::get(double offset) const {
 }
 
 
-// SampeRateConverter-----------------------------------------------------------------------
+// Resampler--------------------------------------------------------------------------------
 
-SampleRateConverter::SampleRateConverter(Frequency inSampleRate_p, Frequency outSampleRate_p, size_t filterLength) :
+size_t Resampler::getFilterLength(Quality quality) {
+  switch(quality) {
+    case Quality::Fast:
+      return 33;
+    case Quality::Medium:
+      return 101;
+    case Quality::Best:
+      return 257;
+  }
+  assert(false);
+  return 101;
+}
+
+static std::optional<uint32_t> wholeSampleRate(Frequency sampleRate) {
+  const double rounded = std::round(sampleRate.Hz());
+  if(rounded <= 0. || rounded != sampleRate.Hz() || rounded > std::numeric_limits<uint32_t>::max()) {
+    return std::nullopt;
+  }
+  return static_cast<uint32_t>(rounded);
+}
+
+// row p is for output p / phases samples after middle of filter, row[i] multiplies input from i samples ago
+static std::vector<double> createPhaseTable(uint32_t phases, size_t filterLength, double fc) {
+  const double middle = static_cast<double>(filterLength / 2);
+  std::vector<double> table(phases * filterLength);
+
+  for(uint32_t p = 0; p < phases; p++) {
+    auto row = std::span<double>(table).subspan(p * filterLength, filterLength);
+    double sum = 0.;
+    for(size_t i = 0; i < filterLength; i++) {
+      const double d = static_cast<double>(i) - middle + static_cast<double>(p) / phases;
+      const double sinc = d == 0. ? 2. * fc : sin(2. * std::numbers::pi * fc * d) / (std::numbers::pi * d);
+      row[i] = WindowFunction::get(WindowFunction::Type::Blackman, 0.5 + 0.5 * d / (middle + 1.)) * sinc;
+      sum += row[i];
+    }
+    // every phase has unity gain, otherwise dc would be modulated by phase
+    for(auto& v : row) {
+      v /= sum;
+    }
+  }
+  return table;
+}
+
+// table depends only on ratio and filter length, so resamplers of many sounds share it, it's freed when the last one is destroyed
+static std::shared_ptr<const std::vector<double>> getPhaseTable(uint32_t phases, uint32_t decimation, size_t filterLength) {
+  static std::mutex mutex;
+  static std::map<std::tuple<uint32_t, uint32_t, size_t>, std::weak_ptr<const std::vector<double>>> tables;
+
+  const std::lock_guard<std::mutex> lock(mutex);
+  auto& cached = tables[{phases, decimation, filterLength}];
+  auto table = cached.lock();
+  if(!table) {
+    const double fc = std::min(phases, decimation) / 2. / decimation;
+    table = std::make_shared<const std::vector<double>>(createPhaseTable(phases, filterLength, fc));
+    cached = table;
+  }
+  return table;
+}
+
+Resampler::Resampler(size_t numberOfChannels_p, Frequency inSampleRate_p, Frequency outSampleRate_p, Quality quality) :
+  Resampler(numberOfChannels_p, inSampleRate_p, outSampleRate_p, getFilterLength(quality)) {}
+
+Resampler::Resampler(size_t numberOfChannels_p, Frequency inSampleRate_p, Frequency outSampleRate_p, size_t filterLength_p) :
+  numberOfChannels(numberOfChannels_p),
   inSampleRate(inSampleRate_p),
   outSampleRate(outSampleRate_p),
-  diffrentSampleRates(inSampleRate != outSampleRate),
+  filterLength(nextOdd(filterLength_p)),
+  history(2 * filterLength * numberOfChannels, 0.),
   step(inSampleRate_p / outSampleRate_p)
 {
-  if(diffrentSampleRates) {
-    filter = SincFilter(inSampleRate, std::min(inSampleRate, outSampleRate) / 2., filterLength, WindowFunction::Type::Blackman);
+  // filters for setOutSampleRateNoFilterUpdate are built here, so switching to them on audio thread doesn't compute or allocate anything
+  sincFilters.assign(numberOfChannels, SincFilter(inSampleRate, std::min(inSampleRate, outSampleRate) / 2., filterLength, WindowFunction::Type::Blackman));
+  if(inSampleRate == outSampleRate) {
+    return;
+  }
+
+  const auto in = wholeSampleRate(inSampleRate);
+  const auto out = wholeSampleRate(outSampleRate);
+  if(in && out) {
+    const uint32_t divisor = std::gcd(*in, *out);
+    if(*out / divisor <= MaxPhases) {
+      mode = Mode::Polyphase;
+      phases = *out / divisor;
+      decimation = *in / divisor;
+      phase = phases;
+      phaseTable = getPhaseTable(phases, decimation, filterLength);
+      return;
+    }
   }
+  switchToSinc();
 }
 
-void SampleRateConverter::setOutSampleRateNoFilterUpdate(Frequency outSampleRate_p) {
+void Resampler::setOutSampleRateNoFilterUpdate(Frequency outSampleRate_p) {
+  if(mode != Mode::Sinc) {
+    switchToSinc();
+  }
   step = inSampleRate / outSampleRate_p;
 }
 
-void SampleRateConverter::push(sample_t in) {
-  if(position >= 1.) {
-    position -= 1.;
-    out = in;
-    if(diffrentSampleRates) {
-      filter.push(in);
+void Resampler::switchToSinc() {
+  // continues from history, so switching during playback doesn't cause click
+  if(mode == Mode::Polyphase) {
+    position = static_cast<double>(phase) / phases;
+  }
+  // history fills whole filter, so prebuilt filters don't need to be cleared
+  for(size_t channel = 0; channel < numberOfChannels; channel++) {
+    const sample_t* past = history.data() + channel * 2 * filterLength + historyPosition;
+    for(size_t i = filterLength; i > 0; i--) {
+      sincFilters[channel].push(past[i - 1]);
     }
   }
+  mode = Mode::Sinc;
 }
 
-bool SampleRateConverter::outReady() {
-  return position < 1.;
+void Resampler::push(std::span<const sample_t> frame) {
+  assert(frame.size() >= numberOfChannels);
+  if(mode == Mode::Sinc) {
+    if(position >= 1.) {
+      position -= 1.;
+      for(size_t channel = 0; channel < numberOfChannels; channel++) {
+        sincFilters[channel].push(frame[channel]);
+      }
+    }
+    return;
+  }
+
+  if(mode == Mode::Polyphase) {
+    if(phase < phases) {
+      return;
+    }
+    phase -= phases;
+  }
+  else {
+    if(position < 1.) {
+      return;
+    }
+    position -= 1.;
+  }
+
+  historyPosition = historyPosition == 0 ? filterLength - 1 : historyPosition - 1;
+  for(size_t channel = 0; channel < numberOfChannels; channel++) {
+    sample_t* channelHistory = history.data() + channel * 2 * filterLength;
+    channelHistory[historyPosition] = frame[channel];
+    channelHistory[historyPosition + filterLength] = frame[channel];
+  }
 }
 
-sample_t SampleRateConverter::get() {
+bool Resampler::outReady() const {
+  return mode == Mode::Polyphase ? phase < phases : position < 1.;
+}
+
+void Resampler::get(std::span<sample_t> frame) {
+  assert(frame.size() >= numberOfChannels);
   if(!outReady()) {
-    return 0.;
+    std::fill(frame.begin(), frame.begin() + numberOfChannels, 0.);
+    return;
+  }
+
+  switch(mode) {
+    case Mode::PassThrough:
+      for(size_t channel = 0; channel < numberOfChannels; channel++) {
+        frame[channel] = history[channel * 2 * filterLength + historyPosition];
+      }
+      position += step;
+      break;
+
+    case Mode::Polyphase: {
+      const double* row = phaseTable->data() + phase * filterLength;
+      for(size_t channel = 0; channel < numberOfChannels; channel++) {
+        const sample_t* past = history.data() + channel * 2 * filterLength + historyPosition;
+        sample_t out = 0.;
+        for(size_t i = 0; i < filterLength; i++) {
+          out += row[i] * past[i];
+        }
+        frame[channel] = out;
+      }
+      phase += decimation;
+      break;
+    }
+
+    case Mode::Sinc:
+      for(size_t channel = 0; channel < numberOfChannels; channel++) {
+        frame[channel] = sincFilters[channel].get(position);
+      }
+      position += step;
+      break;
   }
-  if(diffrentSampleRates) {
-    out = filter.get(position);
+}
+
+size_t Resampler::process(std::span<const sample_t> in, std::span<sample_t> out) {
+  assert(in.size() % numberOfChannels == 0);
+  size_t written = 0;
+  for(size_t i = 0; i < in.size(); i += numberOfChannels) {
+    push(in.subspan(i, numberOfChannels));
+    while(outReady()) {
+      assert(written + numberOfChannels <= out.size());
+      get(out.subspan(written, numberOfChannels));
+      written += numberOfChannels;
+    }
   }
-  position += step;
+  return written / numberOfChannels;
+}
+
+size_t Resampler::getMaxOutputFrames(size_t inFrames) const {
+  return static_cast<size_t>(std::ceil(inFrames / step)) + 1;
+}
+
+size_t Resampler::getNumberOfChannels() const {
+  return numberOfChannels;
+}
+
+bool Resampler::usesPolyphase() const {
+  return mode == Mode::Polyphase;
+}
+
+// SampeRateConverter-----------------------------------------------------------------------
+
+SampleRateConverter::SampleRateConverter(Frequency inSampleRate_p, Frequency outSampleRate_p, size_t filterLength) :
+  resampler(1, inSampleRate_p, outSampleRate_p, filterLength) {}
+
+void SampleRateConverter::setOutSampleRateNoFilterUpdate(Frequency outSampleRate_p) {
+  resampler.setOutSampleRateNoFilterUpdate(outSampleRate_p);
+}
+
+void SampleRateConverter::push(sample_t in) {
+  resampler.push(std::span<const sample_t>(&in, 1));
+}
+
+bool SampleRateConverter::outReady() {
+  return resampler.outReady();
+}
+
+sample_t SampleRateConverter::get() {
+  sample_t out = 0.;
+  resampler.get(std::span<sample_t>(&out, 1));
   return out;
 }
 
@@ -14,7 +14,7 @@ SequenceFilterEffect::SequenceFilterEffect(Parameters parameters_p) : parameters
 void SequenceFilterEffect::process(std::span<const sample_t> in, std::span<sample_t> out) {
   counter++;
   if(counter >= periodInSamples) {      
-    filter.reset(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, Frequency::Hz(dist(gen)), parameters.filterQ));
+    filter.rampTo(Tools::AnalogFilter::Coefficients::create(Tools::AnalogFilter::Parameters::createBandPassParameters(sampleRate, Frequency::Hz(dist(gen)), parameters.filterQ)), Tools::AnalogFilter::ControlInterval);
     counter = 0;            
   }
   out[0] = filter.process(in[0]);    
@@ -16,6 +16,7 @@ void SerialEffect::setEffect(size_t i, std::unique_ptr<Effect> effect) {
   if(sampleRateSet) {
     effects[i]->setSampleRate(sampleRate);
   }
+  effects[i]->setRealTime(realTime);
 }
 
 FrameFormat SerialEffect::getOutputFormat() const {
@@ -57,6 +58,37 @@ void SerialEffect::process(std::span<const sample_t> in, std::span<sample_t> out
   }  
 }
 
+void SerialEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  block1.reserve(frames);
+  block2.reserve(frames);
+  tmpBlock.reserve(frames);
+
+  auto view1 = block1.getView(getInputFormat(), frames);
+  Tools::convertBlock(in, getInputFormat(), view1, getInputFormat(), frames);
+
+  for(int32_t i = 0; i < static_cast<int32_t>(effects.size()) - 1; i++) {
+    auto view2 = block2.getView(effects[i]->getOutputFormat(), frames);
+    if(bypass[i]) {
+      Tools::convertBlock(view1, effects[i]->getInputFormat(), view2, effects[i]->getOutputFormat(), frames);
+      auto tmp = tmpBlock.getView(effects[i]->getOutputFormat(), frames);
+      effects[i]->processBlock(view1, tmp, frames); // so effect have recent data fed even when bypassed
+    }
+    else {
+      effects[i]->processBlock(view1, view2, frames);
+    }
+    view1 = block1.getView(effects[i + 1]->getInputFormat(), frames);
+    Tools::convertBlock(view2, effects[i]->getOutputFormat(), view1, effects[i + 1]->getInputFormat(), frames);
+  }
+  if(bypass.back()) {
+    Tools::convertBlock(view1, effects.back()->getInputFormat(), out, effects.back()->getOutputFormat(), frames);
+    auto tmp = tmpBlock.getView(effects.back()->getOutputFormat(), frames);
+    effects.back()->processBlock(view1, tmp, frames);
+  }
+  else {
+    effects.back()->processBlock(view1, out, frames);
+  }
+}
+
 void SerialEffect::setParameter(size_t id, ParameterValue value) {
   if(id == StartBypassingEffect) {
     bypass[value.getInteger()] = true;
@@ -74,6 +106,13 @@ void SerialEffect::setSampleRate(Frequency sampleRate_p) {
   }
 }
 
+void SerialEffect::setRealTime(bool realTime_p) {
+  realTime = realTime_p;
+  for(auto& effect : effects) {
+    effect->setRealTime(realTime);
+  }
+}
+
 void SerialEffect::setParameter(size_t effectID, size_t id, ParameterValue value) {
   effects[effectID]->setParameter(id, value);
 }
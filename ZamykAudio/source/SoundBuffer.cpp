@@ -48,5 +48,12 @@ size_t SoundBuffer::getLoopEnd() const {
   return loopEnd; 
 }
 
+AudioBlockView SoundBuffer::getView(size_t offset, size_t length) {
+  if(getNumberOfChannels() == 1) {
+    return AudioBlockView(getChannel(0).subspan(offset, length));
+  }
+  return AudioBlockView(getChannel(0).subspan(offset, length), getChannel(1).subspan(offset, length));
+}
+
 
 } // namespace ZAudio
@@ -1,5 +1,9 @@
 #include <ZAudio/SoundCache.h>
 #include <ZAudio/BufferDecoder.h>
+#include <ZAudio/SampleRateConversion.h>
+
+#include <fstream>
+#include <mutex>
 
 namespace ZAudio {
 
@@ -26,10 +30,79 @@ void SoundCache::addLoadingFunction(const std::string& extension, LoadingFunctio
   loadingFunctions.insert({extension, loadingFunction});  
 }
 
-std::optional<CacheSoundID> SoundCache::add(const std::filesystem::path& path, OpenMode openMode) {
+void SoundCache::addMemoryLoadingFunction(const std::string& extension, MemoryLoadingFunction loadingFunction) {
+  memoryLoadingFunctions.insert({extension, loadingFunction});
+}
+
+bool SoundCache::hasLoadingFunction(const std::filesystem::path& path, OpenMode openMode) const {
+  if(openMode == OpenMode::Compressed) {
+    return memoryLoadingFunctions.contains(path.extension().string());
+  }
+  return loadingFunctions.contains(path.extension().string());
+}
+
+static size_t getMemoryUsage(const SoundBuffer& buffer) {
+  return buffer.getLength() * buffer.getNumberOfChannels() * sizeof(sample_t);
+}
+
+ResultValue<std::shared_ptr<SoundBuffer>> SoundCache::decode(const std::filesystem::path& path) const {
   auto it = loadingFunctions.find(path.extension().string());
-  std::string extension = path.extension().string();
   if(it == loadingFunctions.end()) {
+    return Result::error("No loader function for extension " + path.extension().string());
+  }
+  auto res = it->second(path);
+  if(!res) {
+    return Result::error(res.getDescription());
+  }
+  auto sound = decodeSound(*res.get());
+  if(!sound) {
+    return Result::error(sound.getDescription());
+  }
+  return std::make_shared<SoundBuffer>(std::move(sound.get()));
+}
+
+ResultValue<SoundCache::PreBufferedSound> SoundCache::decodePreBuffered(const std::filesystem::path& path) const {
+  auto buffer = decode(path);
+  if(!buffer) {
+    return Result::error(buffer.getDescription());
+  }
+  PreBufferedSound sound{path, buffer.get(), {}, 0};
+  if(targetSampleRate && sound.buffer->getSampleRate() != *targetSampleRate) {
+    sound.converted.push_back(std::make_shared<SoundBuffer>(Tools::convertSampleRateSinc(*sound.buffer, *targetSampleRate)));
+    sound.buffer.reset();
+  }
+  return sound;
+}
+
+ResultValue<SoundCache::CompressedSound> SoundCache::readCompressed(const std::filesystem::path& path) const {
+  std::ifstream file(path, std::ios::binary);
+  if(!file) {
+    return Result::error("Couldn't open file " + path.string());
+  }
+  auto data = std::make_shared<std::vector<uint8_t>>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  // file is checked now, so getSound doesn't fail later
+  CompressedSound sound{path.extension().string(), std::move(data)};
+  auto decoder = memoryLoadingFunctions.at(sound.extension)(sound.data);
+  if(!decoder) {
+    return Result::error(decoder.getDescription());
+  }
+  return sound;
+}
+
+void SoundCache::insertPreBuffered(CacheSoundID id, PreBufferedSound sound) {
+  if(sound.buffer) {
+    statistics.memoryUsage += getMemoryUsage(*sound.buffer);
+  }
+  for(const auto& converted : sound.converted) {
+    statistics.memoryUsage += getMemoryUsage(*converted);
+  }
+  sound.lastUse = ++useCounter;
+  preBufferedSounds.insert({id, std::move(sound)});
+}
+
+std::optional<CacheSoundID> SoundCache::add(const std::filesystem::path& path, OpenMode openMode) {
+  if(!hasLoadingFunction(path, openMode)) {
     error = "No loader function for extension " + path.extension().string();
     return std::nullopt;
   }
@@ -38,17 +111,22 @@ std::optional<CacheSoundID> SoundCache::add(const std::filesystem::path& path, O
   lastID++;
 
   if(openMode == OpenMode::PreBuffer) {
-    auto res = it->second(path);
-    if(!res) {
-      error = res.getDescription();
+    auto sound = decodePreBuffered(path);
+    if(!sound) {
+      error = sound.getDescription();
       return std::nullopt;
-    }    
-    auto sound = decodeSound(*res.get());
+    }
+    insertPreBuffered(id, std::move(sound.get()));
+    evict(id);
+  }
+  else if(openMode == OpenMode::Compressed) {
+    auto sound = readCompressed(path);
     if(!sound) {
       error = sound.getDescription();
       return std::nullopt;
-    }    
-    preBufferedSounds.insert({id, std::make_shared<SoundBuffer>(std::move(sound.get()))});
+    }
+    statistics.compressedMemoryUsage += sound.get().data->size();
+    compressedSounds.insert({id, std::move(sound.get())});
   }
   else {
     streamSounds.insert({id, path});    
@@ -57,12 +135,110 @@ std::optional<CacheSoundID> SoundCache::add(const std::filesystem::path& path, O
   return id;
 }
 
+std::vector<SoundCache::BatchResult> SoundCache::addBatch(const std::vector<std::filesystem::path>& paths, OpenMode openMode, ThreadTools::WorkerPool* pool, const BatchCallback& callback) {
+  // ids are given in order of paths, like when add is called for every path
+  const uint32_t firstID = lastID;
+  lastID += paths.size();
+
+  std::vector<BatchResult> results(paths.size());
+  std::vector<std::optional<PreBufferedSound>> sounds(paths.size());
+  std::vector<std::optional<CompressedSound>> compressed(paths.size());
+  std::mutex mutex;
+
+  auto addTask = [&](size_t i) {
+    BatchResult result;
+    if(!hasLoadingFunction(paths[i], openMode)) {
+      result.error = "No loader function for extension " + paths[i].extension().string();
+    }
+    else if(openMode == OpenMode::PreBuffer) {
+      auto sound = decodePreBuffered(paths[i]);
+      if(sound) {
+        sounds[i] = std::move(sound.get());
+        result.id = CacheSoundID(firstID + i);
+      }
+      else {
+        result.error = sound.getDescription();
+      }
+    }
+    else if(openMode == OpenMode::Compressed) {
+      auto sound = readCompressed(paths[i]);
+      if(sound) {
+        compressed[i] = std::move(sound.get());
+        result.id = CacheSoundID(firstID + i);
+      }
+      else {
+        result.error = sound.getDescription();
+      }
+    }
+    else {
+      result.id = CacheSoundID(firstID + i);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    results[i] = result;
+    if(callback) {
+      callback(i, results[i]);
+    }
+  };
+
+  if(pool != nullptr) {
+    pool->parallelFor(paths.size(), addTask);
+  }
+  else {
+    for(size_t i = 0; i < paths.size(); i++) {
+      addTask(i);
+    }
+  }
+
+  for(size_t i = 0; i < paths.size(); i++) {
+    if(!results[i].id) {
+      continue;
+    }
+    if(sounds[i]) {
+      insertPreBuffered(*results[i].id, std::move(*sounds[i]));
+    }
+    else if(compressed[i]) {
+      statistics.compressedMemoryUsage += compressed[i]->data->size();
+      compressedSounds.insert({*results[i].id, std::move(*compressed[i])});
+    }
+    else {
+      streamSounds.insert({*results[i].id, paths[i]});
+    }
+  }
+  evict();
+  return results;
+}
+
+void SoundCache::remove(CacheSoundID id) {
+  auto it = preBufferedSounds.find(id);
+  if(it != preBufferedSounds.end()) {
+    if(it->second.buffer) {
+      statistics.memoryUsage -= getMemoryUsage(*it->second.buffer);
+    }
+    for(const auto& converted : it->second.converted) {
+      statistics.memoryUsage -= getMemoryUsage(*converted);
+    }
+    preBufferedSounds.erase(it);
+  }
+  auto compressed = compressedSounds.find(id);
+  if(compressed != compressedSounds.end()) {
+    statistics.compressedMemoryUsage -= compressed->second.data->size();
+    compressedSounds.erase(compressed);
+  }
+  streamSounds.erase(id);
+}
+
 std::unique_ptr<FileInput> SoundCache::getSound(CacheSoundID id, bool playing, bool looped, Time position) {
   auto it1 = preBufferedSounds.find(id);
   auto it2 = streamSounds.find(id);
+  auto it3 = compressedSounds.find(id);
 
   if(it1 != preBufferedSounds.end()) {    
-    return std::make_unique<FileInput>(std::make_unique<BufferDecoder>(it1->second), FileInput::Parameters(looped, position, 1., false));
+    auto buffer = getPreBuffered(id, targetSampleRate);
+    if(!buffer) {
+      return nullptr;
+    }
+    return std::make_unique<FileInput>(std::make_unique<BufferDecoder>(buffer), FileInput::Parameters(looped, position, 1., false));
   }
   else if(it2 != streamSounds.end()) {
     auto dec = loadingFunctions[it2->second.extension().string()](it2->second);
@@ -72,11 +248,137 @@ std::unique_ptr<FileInput> SoundCache::getSound(CacheSoundID id, bool playing, b
     }    
     return std::make_unique<FileInput>(std::move(dec.get()), FileInput::Parameters(looped, position, 1., true));
   }
+  else if(it3 != compressedSounds.end()) {
+    auto dec = memoryLoadingFunctions[it3->second.extension](it3->second.data);
+    if(!dec) {
+      error = dec.getDescription();
+      return nullptr;
+    }
+    auto decoder = std::make_unique<ChunkCacheDecoder>(std::move(dec.get()), id.get(), chunkCache);
+    return std::make_unique<FileInput>(std::move(decoder), FileInput::Parameters(looped, position, 1., true));
+  }
   else {
     return nullptr;
   }
 }
 
+std::shared_ptr<const SoundBuffer> SoundCache::getBuffer(CacheSoundID id) {
+  return getPreBuffered(id, std::nullopt);
+}
+
+std::shared_ptr<const SoundBuffer> SoundCache::getBuffer(CacheSoundID id, Frequency sampleRate) {
+  return getPreBuffered(id, sampleRate);
+}
+
+std::shared_ptr<const SoundBuffer> SoundCache::getPreBuffered(CacheSoundID id, std::optional<Frequency> sampleRate) {
+  auto it = preBufferedSounds.find(id);
+  if(it == preBufferedSounds.end()) {
+    return nullptr;
+  }
+  auto& sound = it->second;
+  sound.lastUse = ++useCounter;
+
+  std::shared_ptr<const SoundBuffer> buffer;
+  if(sound.buffer && (!sampleRate || sound.buffer->getSampleRate() == *sampleRate)) {
+    buffer = sound.buffer;
+  }
+  for(const auto& converted : sound.converted) {
+    if(sampleRate && converted->getSampleRate() == *sampleRate) {
+      buffer = converted;
+    }
+  }
+  if(buffer) {
+    statistics.hits++;
+    return buffer;
+  }
+
+  statistics.misses++;
+  if(!sound.buffer) {
+    auto reloaded = decode(sound.path);
+    if(!reloaded) {
+      error = reloaded.getDescription();
+      return nullptr;
+    }
+    sound.buffer = reloaded.get();
+    statistics.memoryUsage += getMemoryUsage(*sound.buffer);
+  }
+  if(!sampleRate || sound.buffer->getSampleRate() == *sampleRate) {
+    buffer = sound.buffer;
+  }
+  else {
+    sound.converted.push_back(std::make_shared<SoundBuffer>(Tools::convertSampleRateSinc(*sound.buffer, *sampleRate)));
+    statistics.memoryUsage += getMemoryUsage(*sound.converted.back());
+    buffer = sound.converted.back();
+    // original is played only from copies now, if it's asked for, it's loaded from path again
+    if(sound.buffer.use_count() == 1) {
+      statistics.memoryUsage -= getMemoryUsage(*sound.buffer);
+      sound.buffer.reset();
+    }
+  }
+  evict(id);
+  return buffer;
+}
+
+void SoundCache::evict(std::optional<CacheSoundID> keep) {
+  if(!memoryBudget) {
+    return;
+  }
+  while(statistics.memoryUsage > *memoryBudget) {
+    // sounds used by FileInputs (or anyone else) can't be evicted
+    auto isEvictable = [](const PreBufferedSound& sound) {
+      if(sound.buffer && sound.buffer.use_count() > 1) {
+        return false;
+      }
+      for(const auto& converted : sound.converted) {
+        if(converted.use_count() > 1) {
+          return false;
+        }
+      }
+      return sound.buffer || !sound.converted.empty();
+    };
+
+    PreBufferedSound* leastRecentlyUsed = nullptr;
+    for(auto& [id, sound] : preBufferedSounds) {
+      if(id == keep || !isEvictable(sound)) {
+        continue;
+      }
+      if(leastRecentlyUsed == nullptr || sound.lastUse < leastRecentlyUsed->lastUse) {
+        leastRecentlyUsed = &sound;
+      }
+    }
+    if(leastRecentlyUsed == nullptr) {
+      return;
+    }
+
+    if(leastRecentlyUsed->buffer) {
+      statistics.memoryUsage -= getMemoryUsage(*leastRecentlyUsed->buffer);
+      leastRecentlyUsed->buffer.reset();
+    }
+    for(const auto& converted : leastRecentlyUsed->converted) {
+      statistics.memoryUsage -= getMemoryUsage(*converted);
+    }
+    leastRecentlyUsed->converted.clear();
+    statistics.evictions++;
+  }
+}
+
+void SoundCache::setTargetSampleRate(std::optional<Frequency> sampleRate) {
+  targetSampleRate = sampleRate;
+}
+
+void SoundCache::setDecodedChunkCacheSize(size_t chunks) {
+  chunkCache = std::make_shared<DecodedChunkCache>(chunks);
+}
+
+void SoundCache::setMemoryBudget(std::optional<size_t> bytes) {
+  memoryBudget = bytes;
+  evict();
+}
+
+SoundCache::Statistics SoundCache::getStatistics() const {
+  return statistics;
+}
+
 std::string SoundCache::getError() const {
   return error;
 }
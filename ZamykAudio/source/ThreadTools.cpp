@@ -1,5 +1,7 @@
 #include <ZAudio/ThreadTools.h>
 
+#include <algorithm>
+
 
 //#define THREADS_POSIX
 
@@ -49,3 +51,199 @@ void ZAudio::ThreadTools::setHighPriority(std::thread& thread) {
 
 #endif
 
+
+namespace ZAudio::ThreadTools {
+
+
+// WorkerPool-----------------------------------------------------------------------------------------------
+
+WorkerPool::WorkerPool(size_t numberOfThreads) {
+  threads.reserve(numberOfThreads);
+  for(size_t i = 0; i < numberOfThreads; i++) {
+    threads.emplace_back(&WorkerPool::workerThread, this);
+    setHighPriority(threads.back());
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock(mutex);
+    stop = true;
+  }
+  startCondition.notify_all();
+  for(auto& thread : threads) {
+    thread.join();
+  }
+}
+
+size_t WorkerPool::getNumberOfThreads() const {
+  return threads.size();
+}
+
+void WorkerPool::run(size_t count_p, Task task_p, void* context_p) {
+  std::unique_lock lock(mutex);
+  task = task_p;
+  context = context_p;
+  count = count_p;
+  next = 0;
+  finished = 0;
+  generation++;
+  startCondition.notify_all();
+
+  takeTasks(lock);
+  finishCondition.wait(lock, [this]() { return finished == count; });
+}
+
+void WorkerPool::takeTasks(std::unique_lock<std::mutex>& lock) {
+  while(next < count) {
+    const size_t i = next++;
+    lock.unlock();
+    task(context, i);
+    lock.lock();
+    finished++;
+    if(finished == count) {
+      finishCondition.notify_all();
+    }
+  }
+}
+
+void WorkerPool::workerThread() {
+  uint64_t seenGeneration = 0;
+  std::unique_lock lock(mutex);
+  while(true) {
+    startCondition.wait(lock, [&]() { return stop || generation != seenGeneration; });
+    if(stop) {
+      return;
+    }
+    seenGeneration = generation;
+    takeTasks(lock);
+  }
+}
+
+// IOExecutor-----------------------------------------------------------------------------------------------
+
+IOExecutor::IOExecutor(size_t numberOfThreads) {
+  setNumberOfThreads(numberOfThreads);
+}
+
+IOExecutor::~IOExecutor() {
+  setNumberOfThreads(0);
+}
+
+IOExecutor& IOExecutor::getShared() {
+  static IOExecutor executor(DefaultNumberOfThreads);
+  return executor;
+}
+
+void IOExecutor::request(Stream& stream) {
+  stream.wanted = true;
+  // stream that is queued or served is queued again after service, because it's wanted
+  if(stream.queued || !mutex.try_lock()) {
+    return;
+  }
+  const bool added = !stream.queued;
+  if(added) {
+    stream.queued = true;
+    pending.push_back(&stream);
+  }
+  mutex.unlock();
+  if(added) {
+    condition.notify_one();
+  }
+}
+
+void IOExecutor::remove(Stream& stream) {
+  std::unique_lock lock(mutex);
+  servedCondition.wait(lock, [&stream]() { return !stream.serving; });
+  std::erase(pending, &stream);
+  stream.queued = false;
+}
+
+void IOExecutor::setNumberOfThreads(size_t numberOfThreads_p) {
+  std::lock_guard resizeLock(resizeMutex);
+  {
+    std::lock_guard lock(mutex);
+    numberOfThreads = numberOfThreads_p;
+  }
+  condition.notify_all();
+  // threads with index over number of threads end themselves
+  while(threads.size() > numberOfThreads_p) {
+    threads.back().join();
+    threads.pop_back();
+  }
+  while(threads.size() < numberOfThreads_p) {
+    threads.emplace_back(&IOExecutor::workerThread, this, threads.size());
+  }
+}
+
+size_t IOExecutor::getNumberOfThreads() const {
+  return threads.size();
+}
+
+void IOExecutor::workerThread(size_t index) {
+  std::unique_lock lock(mutex);
+  while(true) {
+    condition.wait(lock, [&]() { return index >= numberOfThreads || !pending.empty(); });
+    if(index >= numberOfThreads) {
+      // pending streams are left to other threads
+      if(!pending.empty()) {
+        condition.notify_one();
+      }
+      return;
+    }
+    auto it = std::min_element(pending.begin(), pending.end(), [](const Stream* a, const Stream* b) {
+      return a->getBufferedSeconds() < b->getBufferedSeconds();
+    });
+    Stream& stream = **it;
+    *it = pending.back();
+    pending.pop_back();
+    stream.serving = true;
+    lock.unlock();
+
+    stream.wanted = false;
+    const bool more = stream.service();
+
+    lock.lock();
+    stream.serving = false;
+    // queued is cleared before wanted is checked, so request that came in the meantime is either seen here or queues stream itself
+    stream.queued = false;
+    if(more || stream.wanted) {
+      stream.queued = true;
+      pending.push_back(&stream);
+    }
+    servedCondition.notify_all();
+  }
+}
+
+// RenderSignal---------------------------------------------------------------------------------------------
+
+void RenderSignal::requestFrames(size_t frames) {
+  requested.fetch_add(frames);
+  notify();
+}
+
+void RenderSignal::notify() {
+  sequence.fetch_add(1);
+  sequence.notify_one();
+}
+
+size_t RenderSignal::wait() {
+  sequence.wait(seenSequence);
+  seenSequence = sequence.load();
+  const double frames = requested.exchange(0) * ratio + remainder;
+  const size_t whole = static_cast<size_t>(frames);
+  remainder = frames - whole;
+  return whole;
+}
+
+void RenderSignal::setRatio(double ratio_p) {
+  ratio = ratio_p;
+}
+
+void RenderSignal::clear() {
+  requested = 0;
+  remainder = 0.;
+}
+
+
+} // namespace ZAudio::ThreadTools
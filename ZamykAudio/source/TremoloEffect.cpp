@@ -15,6 +15,16 @@ void TremoloEffect::process(std::span<const sample_t> in, std::span<sample_t> ou
   out[0] = in[0] * Volume::dB(lfoOut.bind(parameters.minGain.dB(), parameters.maxGain.dB())).linear();    
 }
 
+void TremoloEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  auto inChannel = in.getChannel(0);
+  auto outChannel = out.getChannel(0);
+  const double minGain = parameters.minGain.dB();
+  const double maxGain = parameters.maxGain.dB();
+  for(size_t i = 0; i < frames; i++) {
+    outChannel[i] = inChannel[i] * Volume::dB(lfo.get().bind(minGain, maxGain)).linear();
+  }
+}
+
 void TremoloEffect::setParameter(size_t id, ParameterValue value) {
   switch(id) {
     case FrequencyID:
@@ -9,6 +9,22 @@ void VolumeControlEffect::process(std::span<const sample_t> in, std::span<sample
   out[0] = in[0] * smoothedParameters.volumeChange.linear();
 }
 
+void VolumeControlEffect::processBlock(const AudioBlockView& in, AudioBlockView& out, size_t frames) {
+  auto inChannel = in.getChannel(0);
+  auto outChannel = out.getChannel(0);
+  size_t i = 0;
+  for(; i < frames && !volumeChangeSmoother.hasEnded(); i++) {
+    smoothedParameters.volumeChange = volumeChangeSmoother.update();
+    outChannel[i] = inChannel[i] * smoothedParameters.volumeChange.linear();
+  }
+  // smoother reached destination, so gain is constant for the rest of the block (it could be set instantly since last block)
+  smoothedParameters.volumeChange = volumeChangeSmoother.getCurrentValue();
+  const double gain = smoothedParameters.volumeChange.linear();
+  for(; i < frames; i++) {
+    outChannel[i] = inChannel[i] * gain;
+  }
+}
+
 void VolumeControlEffect::setParameter(size_t id, ParameterValue value) {
   if(id == VolumeChangeID) {
     volumeChangeSmoother.setDestination(value.getVolume());
@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build_float
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(tests "/root/repo/_gate_build_float/tests/tests")
+set_tests_properties(tests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;71;add_test;/root/repo/CMakeLists.txt;0;")
+subdirs("external")
+subdirs("ZamykAudio")
+subdirs("tests")
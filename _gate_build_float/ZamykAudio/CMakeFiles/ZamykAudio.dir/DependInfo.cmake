@@ -0,0 +1,77 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/ZamykAudio/source/AnalogFilter.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AnalogFilter.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AnalogFilter.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AudioBlock.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioBlock.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioBlock.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AudioDecoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioDecoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioDecoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AudioDelay.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioDelay.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioDelay.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AudioDetector.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioDetector.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioDetector.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AudioEncoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioEncoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioEncoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AudioEngine.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioEngine.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AudioEngine.cpp.o.d"
+  "/root/repo/ZamykAudio/source/AutoWahEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AutoWahEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/AutoWahEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/BitCrusherEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BitCrusherEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BitCrusherEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/BufferDecoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BufferDecoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BufferDecoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/BufferEncoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BufferEncoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BufferEncoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/BypassEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BypassEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/BypassEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/CallbackIO.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/CallbackIO.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/CallbackIO.cpp.o.d"
+  "/root/repo/ZamykAudio/source/ChunkCacheDecoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ChunkCacheDecoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ChunkCacheDecoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/ConvolutionReverbEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ConvolutionReverbEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ConvolutionReverbEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/DelayEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/DelayEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/DelayEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/DuckDelayEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/DuckDelayEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/DuckDelayEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/DynamicsProcessorEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/DynamicsProcessorEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/DynamicsProcessorEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/EffectSerializer.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/EffectSerializer.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/EffectSerializer.cpp.o.d"
+  "/root/repo/ZamykAudio/source/FFT.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FFT.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FFT.cpp.o.d"
+  "/root/repo/ZamykAudio/source/FIR_Filter.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FIR_Filter.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FIR_Filter.cpp.o.d"
+  "/root/repo/ZamykAudio/source/FilterEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FilterEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FilterEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/FlangerEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FlangerEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FlangerEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/FrameFormat.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FrameFormat.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/FrameFormat.cpp.o.d"
+  "/root/repo/ZamykAudio/source/LfoWahEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/LfoWahEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/LfoWahEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/LooperEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/LooperEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/LooperEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/LowFrequencyOscillator.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/LowFrequencyOscillator.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/LowFrequencyOscillator.cpp.o.d"
+  "/root/repo/ZamykAudio/source/MappedWavDecoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/MappedWavDecoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/MappedWavDecoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/Math.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/Math.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/Math.cpp.o.d"
+  "/root/repo/ZamykAudio/source/ModulatedDelay.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ModulatedDelay.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ModulatedDelay.cpp.o.d"
+  "/root/repo/ZamykAudio/source/MonoToStereoAdapter.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/MonoToStereoAdapter.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/MonoToStereoAdapter.cpp.o.d"
+  "/root/repo/ZamykAudio/source/ParallelEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ParallelEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ParallelEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/PhaseShifter.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PhaseShifter.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PhaseShifter.cpp.o.d"
+  "/root/repo/ZamykAudio/source/PhaseVocoder.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PhaseVocoder.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PhaseVocoder.cpp.o.d"
+  "/root/repo/ZamykAudio/source/PhaserEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PhaserEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PhaserEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/PingPongDelayEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PingPongDelayEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PingPongDelayEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/PitchShiftEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PitchShiftEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/PitchShiftEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/ReverseDelayEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ReverseDelayEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ReverseDelayEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/RobotEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/RobotEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/RobotEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/SampleRateConversion.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SampleRateConversion.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SampleRateConversion.cpp.o.d"
+  "/root/repo/ZamykAudio/source/SequenceFilterEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SequenceFilterEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SequenceFilterEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/SerialEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SerialEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SerialEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/SimpleDelay.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SimpleDelay.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SimpleDelay.cpp.o.d"
+  "/root/repo/ZamykAudio/source/SoundBuffer.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SoundBuffer.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SoundBuffer.cpp.o.d"
+  "/root/repo/ZamykAudio/source/SoundCache.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SoundCache.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/SoundCache.cpp.o.d"
+  "/root/repo/ZamykAudio/source/Spatial2dEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/Spatial2dEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/Spatial2dEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/StereoChorusEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StereoChorusEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StereoChorusEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/StereoFlangerEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StereoFlangerEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StereoFlangerEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/StereoPhaserEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StereoPhaserEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StereoPhaserEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/StringTools.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StringTools.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/StringTools.cpp.o.d"
+  "/root/repo/ZamykAudio/source/ThreadTools.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ThreadTools.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/ThreadTools.cpp.o.d"
+  "/root/repo/ZamykAudio/source/TreeDatabase.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/TreeDatabase.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/TreeDatabase.cpp.o.d"
+  "/root/repo/ZamykAudio/source/TremoloEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/TremoloEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/TremoloEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/TubePreampEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/TubePreampEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/TubePreampEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/VibratoEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/VibratoEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/VibratoEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/VolumeControlEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/VolumeControlEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/VolumeControlEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/WaveShapers.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/WaveShapers.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/WaveShapers.cpp.o.d"
+  "/root/repo/ZamykAudio/source/WhisperEffect.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/WhisperEffect.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/WhisperEffect.cpp.o.d"
+  "/root/repo/ZamykAudio/source/WindowFunction.cpp" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/WindowFunction.cpp.o" "gcc" "ZamykAudio/CMakeFiles/ZamykAudio.dir/source/WindowFunction.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
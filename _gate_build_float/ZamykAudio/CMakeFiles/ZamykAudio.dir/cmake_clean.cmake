@@ -0,0 +1,127 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ZamykAudio.dir/source/AnalogFilter.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AnalogFilter.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AudioBlock.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AudioBlock.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AudioDecoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AudioDecoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AudioDelay.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AudioDelay.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AudioDetector.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AudioDetector.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AudioEncoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AudioEncoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AudioEngine.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AudioEngine.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/AutoWahEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/AutoWahEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/BitCrusherEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/BitCrusherEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/BufferDecoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/BufferDecoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/BufferEncoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/BufferEncoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/BypassEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/BypassEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/CallbackIO.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/CallbackIO.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/ChunkCacheDecoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/ChunkCacheDecoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/ConvolutionReverbEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/ConvolutionReverbEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/DelayEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/DelayEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/DuckDelayEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/DuckDelayEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/DynamicsProcessorEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/DynamicsProcessorEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/EffectSerializer.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/EffectSerializer.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/FFT.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/FFT.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/FIR_Filter.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/FIR_Filter.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/FilterEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/FilterEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/FlangerEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/FlangerEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/FrameFormat.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/FrameFormat.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/LfoWahEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/LfoWahEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/LooperEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/LooperEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/LowFrequencyOscillator.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/LowFrequencyOscillator.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/MappedWavDecoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/MappedWavDecoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/Math.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/Math.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/ModulatedDelay.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/ModulatedDelay.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/MonoToStereoAdapter.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/MonoToStereoAdapter.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/ParallelEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/ParallelEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/PhaseShifter.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/PhaseShifter.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/PhaseVocoder.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/PhaseVocoder.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/PhaserEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/PhaserEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/PingPongDelayEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/PingPongDelayEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/PitchShiftEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/PitchShiftEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/ReverseDelayEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/ReverseDelayEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/RobotEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/RobotEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/SampleRateConversion.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/SampleRateConversion.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/SequenceFilterEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/SequenceFilterEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/SerialEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/SerialEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/SimpleDelay.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/SimpleDelay.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/SoundBuffer.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/SoundBuffer.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/SoundCache.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/SoundCache.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/Spatial2dEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/Spatial2dEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/StereoChorusEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/StereoChorusEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/StereoFlangerEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/StereoFlangerEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/StereoPhaserEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/StereoPhaserEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/StringTools.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/StringTools.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/ThreadTools.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/ThreadTools.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/TreeDatabase.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/TreeDatabase.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/TremoloEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/TremoloEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/TubePreampEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/TubePreampEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/VibratoEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/VibratoEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/VolumeControlEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/VolumeControlEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/WaveShapers.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/WaveShapers.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/WhisperEffect.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/WhisperEffect.cpp.o.d"
+  "CMakeFiles/ZamykAudio.dir/source/WindowFunction.cpp.o"
+  "CMakeFiles/ZamykAudio.dir/source/WindowFunction.cpp.o.d"
+  "libZamykAudio.a"
+  "libZamykAudio.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ZamykAudio.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests.dir/Tests.cpp.o"
+  "CMakeFiles/tests.dir/Tests.cpp.o.d"
+  "tests"
+  "tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/AnalogFilter.h>
+#include <ZAudio/PhaseShifter.h>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("AnalogFilter block and bank match per sample filter") {
+  using namespace ZAudio;
+  using Tools::AnalogFilter;
+  constexpr size_t Length = 500;
+  const Frequency sampleRate = Frequency::Hz(44100);
+  const AnalogFilter::Parameters lowPass = AnalogFilter::Parameters::createLowPassParameters(sampleRate, Frequency::Hz(800));
+  const AnalogFilter::Parameters highShelf = AnalogFilter::Parameters::createHighShelfParameters(sampleRate, Frequency::Hz(3000), Volume::dB(6));
+
+  std::vector<sample_t> input(Length);
+  for(size_t i = 0; i < Length; i++) {
+    input[i] = std::sin(i * 0.07) + 0.3 * std::sin(i * 1.3);
+  }
+
+  AnalogFilter lowPassFilter(lowPass);
+  AnalogFilter highShelfFilter(highShelf);
+  std::vector<sample_t> lowPassed(Length);
+  std::vector<sample_t> cascaded(Length);
+  for(size_t i = 0; i < Length; i++) {
+    lowPassed[i] = lowPassFilter.process(input[i]);
+    cascaded[i] = highShelfFilter.process(lowPassed[i]);
+  }
+
+  SECTION("block") {
+    AnalogFilter filter(lowPass);
+    std::vector<sample_t> result(input);
+    std::span<sample_t> samples(result);
+    filter.process(samples.first(123), samples.first(123));
+    filter.process(samples.subspan(123), samples.subspan(123));
+    for(size_t i = 0; i < Length; i++) {
+      REQUIRE_THAT(result[i], Catch::Matchers::WithinAbs(lowPassed[i], 0.000001));
+    }
+  }
+
+  SECTION("independent lanes") {
+    Tools::AnalogFilterBank<2> bank;
+    bank.reset(0, lowPass);
+    bank.reset(1, lowPass);
+    std::vector<sample_t> left(input);
+    std::vector<sample_t> right(Length);
+    for(size_t i = 0; i < Length; i++) {
+      right[i] = -input[i];
+    }
+    bank.process({std::span<const sample_t>(left), std::span<const sample_t>(right)}, {std::span<sample_t>(left), std::span<sample_t>(right)}, Length);
+    for(size_t i = 0; i < Length; i++) {
+      REQUIRE_THAT(left[i], Catch::Matchers::WithinAbs(lowPassed[i], 0.000001));
+      REQUIRE_THAT(right[i], Catch::Matchers::WithinAbs(-lowPassed[i], 0.000001));
+    }
+  }
+
+  SECTION("cascade") {
+    Tools::AnalogFilterBank<2> bank;
+    bank.reset(0, lowPass);
+    bank.reset(1, highShelf);
+    for(size_t i = 0; i < Length; i++) {
+      REQUIRE_THAT(bank.processCascade(input[i]), Catch::Matchers::WithinAbs(cascaded[i], 0.000001));
+    }
+  }
+}
+
+TEST_CASE("PhaseShifter with interpolated coefficients follows per sample update") {
+  using namespace ZAudio;
+  using namespace ZAudio::Tools;
+  constexpr size_t Length = 20000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+  const Frequency rate = Frequency::Hz(2);
+  const std::array<double, 6> minFrequencies = {16, 33, 48, 98, 160, 260};
+  const std::array<double, 6> maxFrequencies = {1600, 3300, 4800, 9800, 16000, 20480};
+
+  LowFrequencyOscillator lfo(sampleRate, rate, LowFrequencyOscillator::ShapeType::Sine);
+  std::array<AnalogFilter, 6> filters;
+  PhaseShifter phaseShifter(sampleRate, 1., rate, 0.);
+  for(size_t i = 0; i < Length; i++) {
+    const sample_t in = std::sin(i * 0.03) * 0.5 + 0.2 * std::sin(i * 0.71);
+    const auto lfoValue = lfo.get();
+    sample_t expected = in;
+    for(size_t j = 0; j < filters.size(); j++) {
+      filters[j].reset(AnalogFilter::Parameters::createAllPassParameters(sampleRate, Frequency::Hz(lfoValue.bind(minFrequencies[j], maxFrequencies[j]))));
+      expected = filters[j].process(expected);
+    }
+    REQUIRE_THAT(phaseShifter.process(in), Catch::Matchers::WithinAbs(expected, 0.001));
+  }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/AudioBlock.h>
+#include <ZAudio/DelayEffect.h>
+#include <ZAudio/DynamicsProcessorEffect.h>
+#include <ZAudio/FilterEffect.h>
+#include <ZAudio/SerialEffect.h>
+#include <ZAudio/TremoloEffect.h>
+#include <ZAudio/VolumeControlEffect.h>
+
+#include <cmath>
+
+namespace {
+
+// processes same signal frame by frame and in blocks of blockSize and compares results
+void requireBlockMatchesFrames(const ZAudio::Effect& prototype, size_t blockSize) {
+  using namespace ZAudio;
+  constexpr size_t Length = 1000;
+  const Frequency sampleRate = Frequency::Hz(44100);
+
+  auto perFrame = prototype.clone();
+  auto perBlock = prototype.clone();
+  perFrame->setSampleRate(sampleRate);
+  perBlock->setSampleRate(sampleRate);
+
+  std::vector<sample_t> input(Length);
+  for(size_t i = 0; i < Length; i++) {
+    input[i] = std::sin(i * 0.05) * (i % 200 < 100 ? 0.9 : 0.1);
+  }
+
+  std::vector<sample_t> expected(Length);
+  for(size_t i = 0; i < Length; i++) {
+    std::array<sample_t, Tools::MaxNumberOfChannels> in = {input[i], 0.};
+    std::array<sample_t, Tools::MaxNumberOfChannels> out = {0., 0.};
+    perFrame->process(in, out);
+    expected[i] = out[0];
+  }
+
+  std::vector<sample_t> result(input);
+  for(size_t start = 0; start < Length; start += blockSize) {
+    const size_t frames = std::min(blockSize, Length - start);
+    AudioBlockView view(std::span<sample_t>(result).subspan(start, frames));
+    perBlock->processBlock(view, view, frames);
+  }
+
+  for(size_t i = 0; i < Length; i++) {
+    REQUIRE_THAT(result[i], Catch::Matchers::WithinAbs(expected[i], 0.000001));
+  }
+}
+
+} // namespace
+
+TEST_CASE("AudioBlock views and conversion") {
+  using namespace ZAudio;
+  AudioBlock block(4);
+  auto stereo = block.getView(FrameFormat::Stereo);
+  REQUIRE(stereo.getNumberOfChannels() == 2);
+  REQUIRE(stereo.getLength() == 4);
+
+  std::array<sample_t, 2> frame = {1., 2.};
+  stereo.setFrame(1, frame);
+  REQUIRE(stereo.getChannel(0)[1] == 1.);
+  REQUIRE(stereo.getChannel(1)[1] == 2.);
+
+  auto sub = stereo.subView(1, 2);
+  REQUIRE(sub.getLength() == 2);
+  REQUIRE(sub.getChannel(1)[0] == 2.);
+
+  AudioBlock monoBlock(4);
+  auto mono = monoBlock.getView(FrameFormat::Mono);
+  Tools::convertBlock(stereo, FrameFormat::Stereo, mono, FrameFormat::Mono, 4);
+  REQUIRE(mono.getChannel(0)[1] == 3.);
+
+  Tools::convertBlock(mono, FrameFormat::Mono, stereo, FrameFormat::Stereo, 4);
+  REQUIRE(stereo.getChannel(0)[1] == 3.);
+  REQUIRE(stereo.getChannel(1)[1] == 3.);
+
+  stereo.clear();
+  REQUIRE(stereo.getChannel(1)[1] == 0.);
+}
+
+TEST_CASE("processBlock matches process") {
+  using namespace ZAudio;
+  for(size_t blockSize : {1, 64, 256, 333}) {
+    requireBlockMatchesFrames(FilterEffect(FilterEffect::Parameters(FilterEffect::Type::LowPass, Frequency::Hz(1000), 0.707)), blockSize);
+    requireBlockMatchesFrames(DelayEffect(DelayEffect::Parameters(Time::miliseconds(5), Volume::linear(0.5), Volume::linear(0.5), Volume::dB(-6))), blockSize);
+    requireBlockMatchesFrames(TremoloEffect(TremoloEffect::Parameters(Frequency::Hz(5), Volume::dB(-12), Volume::dB(0))), blockSize);
+    requireBlockMatchesFrames(DynamicsProcessorEffect(DynamicsProcessorEffect::Parameters(Volume::dB(0), Time::miliseconds(5), Time::miliseconds(50), Volume::dB(-10), 4., false, DynamicsProcessorEffect::Type::Compressor)), blockSize);
+
+    VolumeControlEffect volume(VolumeControlEffect::Parameters(Volume::dB(-6)));
+    requireBlockMatchesFrames(volume, blockSize);
+
+    SerialEffect serial(2);
+    serial.setEffect(0, std::make_unique<FilterEffect>(FilterEffect::Parameters(FilterEffect::Type::HighPass, Frequency::Hz(200), 0.707)));
+    serial.setEffect(1, std::make_unique<TremoloEffect>(TremoloEffect::Parameters(Frequency::Hz(3), Volume::dB(-6), Volume::dB(0))));
+    requireBlockMatchesFrames(serial, blockSize);
+  }
+}
+
+TEST_CASE("VolumeControlEffect processBlock after instant volume change") {
+  using namespace ZAudio;
+  constexpr size_t Length = 64;
+  VolumeControlEffect perFrame(VolumeControlEffect::Parameters(Volume::dB(-6)));
+  perFrame.setSampleRate(Frequency::Hz(44100));
+  VolumeControlEffect perBlock(perFrame);
+
+  std::vector<sample_t> expected(Length);
+  std::vector<sample_t> result(Length, 1.);
+  for(int round = 0; round < 2; round++) {
+    // smoother has already ended, so block path skips it
+    perFrame.setParameter(VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(round == 0 ? 0.25 : 0.75)));
+    perBlock.setParameter(VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(round == 0 ? 0.25 : 0.75)));
+    for(size_t i = 0; i < Length; i++) {
+      std::array<sample_t, Tools::MaxNumberOfChannels> in = {1., 0.};
+      std::array<sample_t, Tools::MaxNumberOfChannels> out = {0., 0.};
+      perFrame.process(in, out);
+      expected[i] = out[0];
+    }
+    std::fill(result.begin(), result.end(), sample_t(1));
+    AudioBlockView view{std::span<sample_t>(result)};
+    perBlock.processBlock(view, view, Length);
+    for(size_t i = 0; i < Length; i++) {
+      REQUIRE_THAT(result[i], Catch::Matchers::WithinAbs(expected[i], 0.000001));
+    }
+  }
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/AudioDecoder.h>
+#include <ZAudio/BufferDecoder.h>
+#include <ZAudio/MappedWavDecoder.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace AudioDecoderTests {
+
+// stereo sound with loop in the middle, sample is its frame index (negative in right channel)
+inline ZAudio::SoundBuffer makeSound(size_t length, size_t loopStart, size_t loopEnd) {
+  using namespace ZAudio;
+  SoundBuffer buffer(Frequency::Hz(44100.), FrameFormat::Stereo, length, loopStart, loopEnd);
+  for(size_t i = 0; i < length; i++) {
+    buffer.setSample(i, 0, i);
+    buffer.setSample(i, 1, -double(i));
+  }
+  return buffer;
+}
+
+// writes wav with given samples (already encoded), returns its path
+inline std::filesystem::path writeWav(const std::string& name, uint16_t formatTag, uint16_t bits, uint16_t channels, const std::vector<uint8_t>& samples) {
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream file(path, std::ios::binary);
+  auto put = [&file](uint32_t v, size_t bytes) {
+    for(size_t i = 0; i < bytes; i++) {
+      file.put(char((v >> (8 * i)) & 0xFF));
+    }
+  };
+  file << "RIFF";
+  put(4 + 8 + 16 + 8 + 6 + 8 + samples.size(), 4);
+  file << "WAVE";
+  file << "fmt ";
+  put(16, 4);
+  put(formatTag, 2);
+  put(channels, 2);
+  put(48000, 4);
+  put(48000 * channels * bits / 8, 4);
+  put(channels * bits / 8, 2);
+  put(bits, 2);
+  // unknown chunks are skipped, odd ones have padding byte
+  file << "junk";
+  put(5, 4);
+  file << "12345" << '\0';
+  file << "data";
+  put(samples.size(), 4);
+  file.write(reinterpret_cast<const char*>(samples.data()), samples.size());
+  return path;
+}
+
+} // namespace AudioDecoderTests
+
+TEST_CASE("BufferDecoder reads blocks of frames like single frames") {
+  using namespace ZAudio;
+  auto sound = std::make_shared<const SoundBuffer>(AudioDecoderTests::makeSound(1000, 200, 700));
+  for(bool looped : {false, true}) {
+    BufferDecoder bulk(sound);
+    BufferDecoder single(sound);
+    bulk.setLooped(looped);
+    single.setLooped(looped);
+
+    std::vector<sample_t> block(2 * 333);
+    std::array<sample_t, 2> frame;
+    size_t total = 0;
+    for(int i = 0; i < 10; i++) {
+      const size_t got = bulk.read(block, 333);
+      REQUIRE(got == (looped ? 333 : std::min<size_t>(333, 1000 - total)));
+      for(size_t j = 0; j < got; j++) {
+        REQUIRE(single.get(frame));
+        REQUIRE(block[2 * j] == frame[0]);
+        REQUIRE(block[2 * j + 1] == frame[1]);
+      }
+      total += got;
+    }
+    REQUIRE(bulk.getPosition() == single.getPosition());
+    REQUIRE(single.get(frame) == looped);
+  }
+}
+
+TEST_CASE("decodeSound reads whole sound") {
+  using namespace ZAudio;
+  const SoundBuffer sound = AudioDecoderTests::makeSound(10000, 0, 10000);
+  BufferDecoder decoder{SoundBuffer(sound)};
+  auto decoded = decodeSound(decoder);
+  REQUIRE(decoded);
+  REQUIRE(decoded.get().getLength() == sound.getLength());
+  for(size_t c = 0; c < 2; c++) {
+    auto expected = sound.getChannel(c);
+    auto got = decoded.get().getChannel(c);
+    REQUIRE(std::equal(expected.begin(), expected.end(), got.begin()));
+  }
+}
+
+TEST_CASE("AsyncDecoder never waits for its decoder") {
+  using namespace ZAudio;
+  // decoder thread is let to read only allowed number of blocks
+  struct GatedDecoder : public BufferDecoder {
+    using BufferDecoder::BufferDecoder;
+    std::atomic_int allowedReads{1};
+    size_t read(std::span<sample_t> interleaved, size_t frames) override {
+      while(allowedReads == 0) {
+        std::this_thread::yield();
+      }
+      allowedReads--;
+      return BufferDecoder::read(interleaved, frames);
+    }
+  };
+  auto waitFor = [](auto condition) {
+    for(int i = 0; i < 5000; i++) {
+      if(condition()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  };
+
+  auto gated = std::make_unique<GatedDecoder>(AudioDecoderTests::makeSound(10000, 0, 10000));
+  auto& gate = *gated;
+  AsyncDecoder decoder(std::move(gated), Time::seconds(1));
+
+  // first block is decoded in constructor
+  std::vector<sample_t> block(2 * AsyncDecoder::BlockFrames);
+  REQUIRE(decoder.read(block, AsyncDecoder::BlockFrames) == AsyncDecoder::BlockFrames);
+  REQUIRE(block[2 * 1000] == 1000);
+  REQUIRE(decoder.read(block, 10) == 10);
+  REQUIRE(block[0] == 0.);
+  REQUIRE(decoder.getUnderruns() == 1);
+
+  gate.allowedReads = 1000;
+  REQUIRE(waitFor([&]() { return decoder.getBufferedFrames() == 10000 - AsyncDecoder::BlockFrames; }));
+  REQUIRE(decoder.read(block, 1) == 1);
+  REQUIRE(block[0] == AsyncDecoder::BlockFrames);
+
+  // reader gets silence until decoder thread seeks
+  decoder.seek(5000);
+  REQUIRE(decoder.getPosition() == 5000);
+  REQUIRE(waitFor([&]() {
+    decoder.read(block, 1);
+    return block[0] != 0.;
+  }));
+  REQUIRE(block[0] == 5000);
+  REQUIRE(block[1] == -5000);
+  REQUIRE(waitFor([&]() { return decoder.getBufferedFrames() == 4999; }));
+  REQUIRE(decoder.read(block, 1000) == 1000);
+  REQUIRE(block[0] == 5001);
+  REQUIRE(decoder.getPosition() == 6001);
+
+  block.resize(2 * 5000);
+  REQUIRE(decoder.read(block, 5000) == 3999);
+  REQUIRE(decoder.read(block, 1) == 0);
+  REQUIRE(decoder.getUnderruns() == 1);
+}
+
+TEST_CASE("MappedWavDecoder reads pcm from mapped file") {
+  using namespace ZAudio;
+  SECTION("16 bit stereo") {
+    // frames (0, -1), (0.5, 0.25), looped
+    auto path = AudioDecoderTests::writeWav("ZAudioMapped16.wav", 1, 16, 2, {0x00, 0x00, 0x00, 0x80, 0x00, 0x40, 0x00, 0x20});
+    auto decoder = MappedWavDecoder::load(path);
+    REQUIRE(decoder);
+    auto& d = *decoder.get();
+    REQUIRE(d.getFormat() == FrameFormat::Stereo);
+    REQUIRE(d.getSampleRate() == Frequency::Hz(48000.));
+    REQUIRE(d.getLength() == 2);
+
+    std::vector<sample_t> out(2 * 5);
+    REQUIRE(d.read(out, 5) == 2);
+    REQUIRE(out[0] == 0.);
+    REQUIRE(out[1] == -1.);
+    REQUIRE(out[2] == 0.5);
+    REQUIRE(out[3] == 0.25);
+
+    d.setLooped(true);
+    d.seek(1);
+    REQUIRE(d.read(out, 5) == 5);
+    REQUIRE(std::vector<sample_t>(out.begin(), out.begin() + 6) == std::vector<sample_t>{0.5, 0.25, 0., -1., 0.5, 0.25});
+    std::filesystem::remove(path);
+  }
+  SECTION("24 bit mono") {
+    auto path = AudioDecoderTests::writeWav("ZAudioMapped24.wav", 1, 24, 1, {0x00, 0x00, 0xC0, 0x00, 0x00, 0x40, 0x00, 0x00});
+    auto decoder = MappedWavDecoder::load(path);
+    REQUIRE(decoder);
+    // last frame is cut in the middle
+    REQUIRE(decoder.get()->getLength() == 2);
+    std::array<sample_t, 1> frame;
+    REQUIRE(decoder.get()->get(frame));
+    REQUIRE(frame[0] == -0.5);
+    REQUIRE(decoder.get()->get(frame));
+    REQUIRE(frame[0] == 0.5);
+    REQUIRE_FALSE(decoder.get()->get(frame));
+    std::filesystem::remove(path);
+  }
+  SECTION("float matches decodeSound") {
+    std::vector<float> values;
+    for(int i = 0; i < 20000; i++) {
+      values.push_back(std::sin(i * 0.01f));
+    }
+    std::vector<uint8_t> bytes(values.size() * sizeof(float));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    auto path = AudioDecoderTests::writeWav("ZAudioMappedFloat.wav", 3, 32, 1, bytes);
+    auto decoder = MappedWavDecoder::load(path);
+    REQUIRE(decoder);
+    auto sound = decodeSound(*decoder.get());
+    REQUIRE(sound);
+    REQUIRE(sound.get().getLength() == values.size());
+    for(size_t i = 0; i < values.size(); i++) {
+      REQUIRE(sound.get().getSample(i, 0) == sample_t(values[i]));
+    }
+    std::filesystem::remove(path);
+  }
+  SECTION("unsupported files") {
+    auto path = AudioDecoderTests::writeWav("ZAudioMappedAdpcm.wav", 2, 4, 1, {0x00});
+    REQUIRE_FALSE(MappedWavDecoder::load(path));
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(MappedWavDecoder::load(std::filesystem::temp_directory_path() / "ZAudioMappedMissing.wav"));
+  }
+}
+
+TEST_CASE("AsyncDecoder doesn't discard buffer while seek is pending") {
+  using namespace ZAudio;
+  // decoder thread is held in seek until it's opened
+  struct GatedSeekDecoder : public BufferDecoder {
+    using BufferDecoder::BufferDecoder;
+    std::atomic_bool open{false};
+    void seek(uint64_t position) override {
+      while(!open) {
+        std::this_thread::yield();
+      }
+      BufferDecoder::seek(position);
+    }
+  };
+
+  auto gated = std::make_unique<GatedSeekDecoder>(AudioDecoderTests::makeSound(10000, 0, 10000));
+  auto& gate = *gated;
+  AsyncDecoder decoder(std::move(gated), Time::seconds(1));
+
+  // samples decoded after seek can be pushed between any two steps of read, so buffer is left to decoder thread
+  std::vector<sample_t> block(2);
+  const size_t buffered = decoder.getBufferedFrames();
+  REQUIRE(buffered > 0);
+  decoder.seek(5000);
+  for(int i = 0; i < 10; i++) {
+    REQUIRE(decoder.read(block, 1) == 1);
+    REQUIRE(block[0] == 0.);
+  }
+  REQUIRE(decoder.getBufferedFrames() >= buffered);
+
+  gate.open = true;
+  do {
+    REQUIRE(decoder.read(block, 1) == 1);
+  } while(block[0] == 0.);
+  REQUIRE(block[0] == 5000);
+  REQUIRE(decoder.getPosition() == 5001);
+}
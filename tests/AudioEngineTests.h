@@ -0,0 +1,517 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/AudioEngine.h>
+#include <ZAudio/AudioDecoder.h>
+#include <ZAudio/AudioEncoder.h>
+#include <ZAudio/BufferDecoder.h>
+#include <ZAudio/BufferEncoder.h>
+#include <ZAudio/BypassEffect.h>
+#include <ZAudio/DelayEffect.h>
+#include <ZAudio/DynamicsProcessorEffect.h>
+#include <ZAudio/FilterEffect.h>
+#include <ZAudio/SerialEffect.h>
+#include <ZAudio/VolumeControlEffect.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+// holds engine thread in the middle of block, so command queue can be filled
+struct GateEffect : public ZAudio::BypassEffect {
+  GateEffect(std::atomic_bool& entered_p, std::atomic_bool& open_p) : BypassEffect(ZAudio::FrameFormat::Mono, ZAudio::FrameFormat::Mono), entered(entered_p), open(open_p) {}
+  std::atomic_bool& entered;
+  std::atomic_bool& open;
+  void processBlock(const ZAudio::AudioBlockView& in, ZAudio::AudioBlockView& out, size_t frames) override {
+    entered = true;
+    while(!open) {
+      std::this_thread::yield();
+    }
+    BypassEffect::processBlock(in, out, frames);
+  }
+};
+
+// engine with mixer, whose effect is GateEffect
+struct GatedEngine {
+  std::atomic_bool entered{false};
+  std::atomic_bool open{false};
+  ZAudio::SoundBuffer recorded;
+  ZAudio::AudioEngine engine;
+
+  explicit GatedEngine(ZAudio::AudioEngine::QueuePolicy policy) :
+    recorded(ZAudio::Frequency::Hz(48000), ZAudio::FrameFormat::Mono, 48000),
+    engine(ZAudio::Frequency::Hz(48000), ZAudio::AudioEngine::Parameters(20, 64, 0, false, policy))
+  {
+    using namespace ZAudio;
+    auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+    auto mixer = engine.addMixer(FrameFormat::Mono);
+    engine.addMixerOutput(mixer, output);
+    engine.play(mixer, engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(Frequency::Hz(48000), FrameFormat::Mono, 48000)), FileInput::Parameters()));
+    engine.setMixerEffect(mixer, engine.addEffect<GateEffect>(entered, open));
+    while(!entered) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+// notices when processBlock is entered by two threads at once
+struct OverlapEffect : public ZAudio::BypassEffect {
+  OverlapEffect(std::atomic_bool& overlapped_p) : BypassEffect(ZAudio::FrameFormat::Mono, ZAudio::FrameFormat::Mono), overlapped(overlapped_p) {}
+  std::atomic_bool& overlapped;
+  std::atomic_int inside{0};
+  void processBlock(const ZAudio::AudioBlockView& in, ZAudio::AudioBlockView& out, size_t frames) override {
+    if(++inside > 1) {
+      overlapped = true;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    BypassEffect::processBlock(in, out, frames);
+    inside--;
+  }
+};
+
+} // namespace
+
+
+TEST_CASE("AudioEngine offline render") {
+  using namespace ZAudio;
+  constexpr size_t Length = 1000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, Length);
+  for(size_t i = 0; i < Length; i++) {
+    sound.setSample(i, 0, std::sin(i * 0.05) * 0.5);
+  }
+
+  auto render = [&](size_t workerThreads, bool withEffect) {
+    SoundBuffer recorded(sampleRate, FrameFormat::Stereo, Length + 200);
+    AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64, workerThreads, true));
+    auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+    auto mixer = engine.addMixer(FrameFormat::Stereo);
+    engine.addMixerOutput(mixer, output);
+    auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+    if(withEffect) {
+      engine.play(mixer, input, engine.addEffect<FilterEffect>(FilterEffect::Parameters(FilterEffect::Type::LowPass, Frequency::Hz(2000), 0.707)));
+    }
+    else {
+      engine.play(mixer, input);
+    }
+    REQUIRE(engine.isPlaying(input));
+    engine.render(Length / 2);
+    REQUIRE(engine.isPlaying(input));
+    REQUIRE(engine.getOutputValue(input, FileInput::GetPositionID).getTime().seconds() == Approx(Time::seconds((Length / 2) / sampleRate.Hz()).seconds()));
+    engine.render(Length / 2 + 100);
+    REQUIRE_FALSE(engine.isPlaying(input));
+    return recorded;
+  };
+
+  auto recorded = render(0, false);
+  for(size_t i = 0; i < Length; i++) {
+    REQUIRE(recorded.getSample(i, 0) == Approx(sound.getSample(i, 0)));
+    REQUIRE(recorded.getSample(i, 1) == Approx(sound.getSample(i, 0)));
+  }
+
+  auto serial = render(0, true);
+  auto parallel = render(2, true);
+  for(size_t i = 0; i < serial.getLength(); i++) {
+    REQUIRE(serial.getSample(i, 0) == parallel.getSample(i, 0));
+  }
+}
+
+TEST_CASE("AudioEngine render matches reference with both sample types") {
+  using namespace ZAudio;
+  constexpr size_t Length = 4000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  // input has other sample rate, so it's resampled
+  SoundBuffer sound(Frequency::Hz(44100), FrameFormat::Mono, Length);
+  for(size_t i = 0; i < Length; i++) {
+    sound.setSample(i, 0, std::sin(i * 0.03) * 0.6 + std::sin(i * 0.31) * 0.3);
+  }
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, Length);
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64, 0, true));
+  auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  engine.addMixerOutput(mixer, output);
+  engine.setMixerEffect(mixer, engine.addEffect<DynamicsProcessorEffect>(DynamicsProcessorEffect::Parameters(Volume::dB(0), Time::miliseconds(5), Time::miliseconds(50), Volume::dB(-12), 4., false, DynamicsProcessorEffect::Type::Compressor)));
+  auto chain = std::make_unique<SerialEffect>(3);
+  chain->setEffect(0, std::make_unique<FilterEffect>(FilterEffect::Parameters(FilterEffect::Type::LowPass, Frequency::Hz(4000), 0.707)));
+  chain->setEffect(1, std::make_unique<FilterEffect>(FilterEffect::Parameters(FilterEffect::Type::HighPass, Frequency::Hz(100), 0.707)));
+  chain->setEffect(2, std::make_unique<DelayEffect>(DelayEffect::Parameters(Time::miliseconds(10), Volume::dB(0), Volume::dB(-6), Volume::dB(-9))));
+  engine.play(mixer, engine.addInput<FileInput>(std::make_unique<BufferDecoder>(std::move(sound)), FileInput::Parameters()), engine.addEffect(std::move(chain)));
+  engine.render(Length);
+
+  // rendered by build with double samples, float samples differ by about 2e-6
+  const std::array<double, 20> reference = {
+    0.000000000, -0.189730556, -0.112733995, -0.038302860, 0.048790427,
+    0.067922090, 0.028788947, -0.041772980, -0.096109823, -0.098548513,
+    -0.040589759, 0.051605714, 0.129989666, 0.154224390, 0.109525246,
+    0.016342373, -0.077833897, -0.128916568, -0.115170258, -0.050340934
+  };
+  for(size_t i = 0; i < reference.size(); i++) {
+    REQUIRE_THAT(recorded.getSample(i * 200, 0), Catch::Matchers::WithinAbs(reference[i], 0.00001));
+  }
+}
+
+TEST_CASE("AudioEngine shared effects are not processed in parallel") {
+  using namespace ZAudio;
+  constexpr size_t Length = 2000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  std::atomic_bool inputOverlapped{false};
+  std::atomic_bool mixerOverlapped{false};
+  SoundBuffer recorded1(sampleRate, FrameFormat::Mono, Length);
+  SoundBuffer recorded2(sampleRate, FrameFormat::Mono, Length);
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64, 4, true));
+  auto mixer1 = engine.addMixer(FrameFormat::Mono);
+  auto mixer2 = engine.addMixer(FrameFormat::Mono);
+  engine.addMixerOutput(mixer1, engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded1)));
+  engine.addMixerOutput(mixer2, engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded2)));
+  auto mixerEffect = engine.addEffect<OverlapEffect>(mixerOverlapped);
+  engine.setMixerEffect(mixer1, mixerEffect);
+  engine.setMixerEffect(mixer2, mixerEffect);
+
+  // one effect used by several plays on both mixers
+  auto inputEffect = engine.addEffect<OverlapEffect>(inputOverlapped);
+  for(size_t i = 0; i < 4; i++) {
+    SoundBuffer sound(sampleRate, FrameFormat::Mono, Length);
+    auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(std::move(sound)), FileInput::Parameters());
+    engine.play(i % 2 ? mixer1 : mixer2, input, inputEffect);
+  }
+  engine.render(Length);
+  REQUIRE_FALSE(inputOverlapped);
+  REQUIRE_FALSE(mixerOverlapped);
+}
+
+TEST_CASE("AudioEngine isPlaying before play") {
+  using namespace ZAudio;
+  constexpr size_t Length = 256;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, Length);
+  for(size_t i = 0; i < Length; i++) {
+    sound.setSample(i, 0, 0.5);
+  }
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, Length);
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64, 0, true));
+  auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  engine.addMixerOutput(mixer, output);
+  auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+
+  // asking must not leave anything behind, that play would use instead of the input
+  REQUIRE_FALSE(engine.isPlaying(input));
+  engine.play(mixer, input);
+  REQUIRE(engine.isPlaying(input));
+  engine.render(Length);
+  for(size_t i = 0; i < Length; i++) {
+    REQUIRE(recorded.getSample(i, 0) == Approx(0.5));
+  }
+}
+
+TEST_CASE("AudioEngine CommandBatch") {
+  using namespace ZAudio;
+  constexpr size_t Length = 1000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, Length);
+  for(size_t i = 0; i < Length; i++) {
+    sound.setSample(i, 0, 0.5);
+  }
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, Length);
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64, 0, true));
+  auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+  auto effect = engine.addEffect<VolumeControlEffect>(VolumeControlEffect::Parameters());
+
+  AudioEngine::CommandBatch batch;
+  batch.addMixerOutput(mixer, output);
+  batch.play(mixer, input, effect);
+  for(int i = 0; i <= 1000; i++) {
+    batch.setEffectParameter(effect, VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(i / 1000.)));
+    batch.setEffectParameter(effect, VolumeControlEffect::MaxChangePerSecondID, ParameterValue::volume(Volume::dB(60)));
+  }
+  // only the last value of every parameter is kept
+  REQUIRE(batch.size() == 4);
+  batch.setEffectParameter(effect, VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(0.5)));
+  REQUIRE(batch.size() == 4);
+
+  REQUIRE_FALSE(engine.isPlaying(input));
+  engine.submit(std::move(batch));
+  REQUIRE(engine.isPlaying(input));
+  engine.render(Length);
+  for(size_t i = 0; i < Length; i++) {
+    REQUIRE(recorded.getSample(i, 0) == Approx(0.25));
+  }
+
+  AudioEngine::CommandBatch empty;
+  REQUIRE(empty.empty());
+  engine.submit(std::move(empty));
+}
+
+TEST_CASE("AudioEngine playAt and stopAt") {
+  using namespace ZAudio;
+  constexpr size_t Length = 1000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, Length);
+  for(size_t i = 0; i < Length; i++) {
+    sound.setSample(i, 0, 0.5);
+  }
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, Length);
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64, 0, true));
+  auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  engine.addMixerOutput(mixer, output);
+  auto first = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+  auto second = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+
+  // start and end aren't on block boundaries
+  engine.playAt(mixer, first, 100);
+  engine.stopAt(mixer, first, 301);
+  AudioEngine::CommandBatch batch;
+  batch.playAt(mixer, second, 200);
+  batch.stopAt(mixer, second, 650);
+  engine.submit(std::move(batch));
+  REQUIRE_FALSE(engine.isPlaying(first));
+
+  engine.render(250);
+  REQUIRE(engine.getFrame() == 250);
+  REQUIRE(engine.isPlaying(first));
+  engine.render(Length - 250);
+  REQUIRE(engine.getFrame() == Length);
+  REQUIRE_FALSE(engine.isPlaying(first));
+  REQUIRE_FALSE(engine.isPlaying(second));
+
+  for(size_t i = 0; i < Length; i++) {
+    const double expected = 0.5 * ((i >= 100 && i < 301) + (i >= 200 && i < 650));
+    REQUIRE(recorded.getSample(i, 0) == Approx(expected));
+  }
+
+  // command for frame that has already been rendered is run at once
+  engine.playAt(mixer, first, 10);
+  REQUIRE(engine.isPlaying(first));
+}
+
+TEST_CASE("AudioEngine parameters set at frame") {
+  using namespace ZAudio;
+  constexpr size_t Length = 1000;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, Length);
+  for(size_t i = 0; i < Length; i++) {
+    sound.setSample(i, 0, 1.);
+  }
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, Length);
+  // whole sound is one block, so only splitting makes changes sample accurate
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, Length, 0, true));
+  auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  engine.addMixerOutput(mixer, output);
+  auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+  auto effect = engine.addEffect<VolumeControlEffect>(VolumeControlEffect::Parameters());
+  engine.play(mixer, input, effect);
+
+  engine.setEffectParameter(effect, VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(0.5)), 100);
+  AudioEngine::CommandBatch batch;
+  for(auto [frame, volume] : {std::pair<uint64_t, double>(333, 0.25), std::pair<uint64_t, double>(600, 0.75)}) {
+    batch.setEffectParameter(effect, VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(0.)), frame);
+    batch.setEffectParameter(effect, VolumeControlEffect::SetVolumeChangeNoSmoothingID, ParameterValue::volume(Volume::linear(volume)), frame);
+  }
+  // only values for the same frame replace each other
+  REQUIRE(batch.size() == 2);
+  engine.submit(std::move(batch));
+  engine.render(Length);
+
+  for(size_t i = 0; i < Length; i++) {
+    const double expected = i < 100 ? 1. : i < 333 ? 0.5 : i < 600 ? 0.25 : 0.75;
+    REQUIRE(recorded.getSample(i, 0) == Approx(expected));
+  }
+}
+
+TEST_CASE("AudioEngine queries read published state") {
+  using namespace ZAudio;
+  const Frequency sampleRate = Frequency::Hz(48000);
+  const size_t length = sampleRate.Hz() / 5;
+
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, length);
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, length * 10);
+  AudioEngine engine(sampleRate, AudioEngine::Parameters(20, 64));
+  auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  engine.addMixerOutput(mixer, output);
+  auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(SoundBuffer(sound)), FileInput::Parameters());
+  REQUIRE_FALSE(engine.isPlaying(input));
+
+  // query after command sees its result, even before engine published state after it
+  engine.play(mixer, input);
+  REQUIRE(engine.isPlaying(input));
+  REQUIRE(engine.getOutputValue(input, FileInput::GetLengthID).getTime().seconds() == Approx(0.2));
+
+  double lastPosition = 0.;
+  const auto start = std::chrono::steady_clock::now();
+  while(engine.isPlaying(input) && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+    const double position = engine.getOutputValue(input, FileInput::GetPositionID).getTime().seconds();
+    REQUIRE(position >= lastPosition);
+    lastPosition = position;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE_FALSE(engine.isPlaying(input));
+  REQUIRE(lastPosition > 0.);
+  REQUIRE_FALSE(engine.hasEnded(output));
+
+  engine.setOutputParameter(output, FileOutput::StopID, ParameterValue());
+  REQUIRE(engine.hasEnded(output));
+}
+
+TEST_CASE("AudioEngine commands from many threads") {
+  using namespace ZAudio;
+  // output value id is the last value of parameter with the same id
+  struct LastValueEffect : public BypassEffect {
+    LastValueEffect() : BypassEffect(FrameFormat::Mono, FrameFormat::Mono) {}
+    std::array<ParameterValue, 4> values;
+    void setParameter(size_t id, ParameterValue value) override {
+      values[id] = value;
+    }
+    ParameterValue getOutputValue(size_t id) override {
+      return values[id];
+    }
+  };
+  constexpr int Threads = 4;
+  constexpr int Values = 20000;
+
+  for(auto policy : {AudioEngine::QueuePolicy::Block, AudioEngine::QueuePolicy::Drop, AudioEngine::QueuePolicy::OverwriteLatest}) {
+    AudioEngine engine(Frequency::Hz(48000), AudioEngine::Parameters(20, 64, 0, false, policy));
+    auto effect = engine.addEffect<LastValueEffect>();
+    std::vector<std::thread> threads;
+    for(int t = 0; t < Threads; t++) {
+      threads.emplace_back([&, t]() {
+        for(int i = 1; i <= Values; i++) {
+          engine.setEffectParameter(effect, t, ParameterValue::integer(i));
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    for(int t = 0; t < Threads; t++) {
+      const int last = engine.getOutputValue(effect, t).getInteger();
+      if(policy == AudioEngine::QueuePolicy::Drop) {
+        REQUIRE(last <= Values);
+      }
+      else {
+        REQUIRE(last == Values);
+      }
+    }
+    if(policy != AudioEngine::QueuePolicy::Drop) {
+      REQUIRE(engine.getNumberOfDroppedCommands() == 0);
+    }
+    REQUIRE(engine.getNumberOfDroppedCommands() <= Threads * Values);
+  }
+}
+
+TEST_CASE("AudioEngine OverwriteLatest keeps order of commands") {
+  using namespace ZAudio;
+  // engine waits with the first value until batch is submitted, so batch that went to queue would be in front of values kept aside
+  struct LastValueEffect : public BypassEffect {
+    explicit LastValueEffect(std::atomic_bool& submitted_p) : BypassEffect(FrameFormat::Mono, FrameFormat::Mono), submitted(submitted_p) {}
+    std::atomic_bool& submitted;
+    ParameterValue value;
+    void setParameter(size_t, ParameterValue value_p) override {
+      while(!submitted) {
+        std::this_thread::yield();
+      }
+      value = value_p;
+    }
+    ParameterValue getOutputValue(size_t) override {
+      return value;
+    }
+  };
+  std::atomic_bool submitted{false};
+  GatedEngine gated(AudioEngine::QueuePolicy::OverwriteLatest);
+  auto& engine = gated.engine;
+  auto effect = engine.addEffect<LastValueEffect>(submitted);
+
+  // queue gets full, the last values are kept aside
+  for(int i = 1; i <= 1000; i++) {
+    engine.setEffectParameter(effect, 0, ParameterValue::integer(i));
+  }
+  // batch isn't parameter command, but it must not overtake values kept aside
+  AudioEngine::CommandBatch batch;
+  batch.setEffectParameter(effect, 0, ParameterValue::integer(-1));
+  // batch that waits for place in queue needs engine running
+  std::thread opener([&gated]() {
+    gated.open = true;
+  });
+  engine.submit(std::move(batch));
+  submitted = true;
+  opener.join();
+  REQUIRE(engine.getOutputValue(effect, 0).getInteger() == -1);
+}
+
+TEST_CASE("AudioEngine OverwriteLatest limits commands kept aside") {
+  using namespace ZAudio;
+  constexpr int Commands = 1000;
+  GatedEngine gated(AudioEngine::QueuePolicy::OverwriteLatest);
+  auto& engine = gated.engine;
+  auto effect = engine.addEffect<VolumeControlEffect>(VolumeControlEffect::Parameters());
+  auto mixer = engine.addMixer(FrameFormat::Mono);
+  auto mixerEffect = engine.addEffect<BypassEffect>(FrameFormat::Mono, FrameFormat::Mono);
+  for(int i = 0; i < Commands; i++) {
+    engine.setEffectParameter(effect, VolumeControlEffect::VolumeChangeID, ParameterValue::volume(Volume::dB(-i * 0.01)));
+  }
+
+  // commands after parameters kept aside are kept aside too, but only about queue size of them, then caller waits
+  std::atomic_int pushed{0};
+  std::thread producer([&]() {
+    for(int i = 0; i < Commands; i++) {
+      engine.setMixerEffect(mixer, mixerEffect);
+      pushed++;
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  REQUIRE(pushed < Commands);
+  gated.open = true;
+  producer.join();
+  REQUIRE(pushed == Commands);
+}
+
+TEST_CASE("AudioEngine Drop drops only parameters") {
+  using namespace ZAudio;
+  const Frequency sampleRate = Frequency::Hz(48000);
+  SoundBuffer sound(sampleRate, FrameFormat::Mono, 480);
+  for(size_t i = 0; i < sound.getLength(); i++) {
+    sound.setSample(i, 0, 0.5);
+  }
+  SoundBuffer recorded(sampleRate, FrameFormat::Mono, sampleRate.Hz());
+  {
+    GatedEngine gated(AudioEngine::QueuePolicy::Drop);
+    auto& engine = gated.engine;
+    auto effect = engine.addEffect<VolumeControlEffect>(VolumeControlEffect::Parameters());
+    for(int i = 0; i < 1000; i++) {
+      engine.setEffectParameter(effect, VolumeControlEffect::VolumeChangeID, ParameterValue::volume(Volume::dB(-i * 0.01)));
+    }
+    REQUIRE(engine.getNumberOfDroppedCommands() > 0);
+
+    // queue is full, so these wait until engine goes on
+    std::thread opener([&gated]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      gated.open = true;
+    });
+    auto output = engine.addOutput<FileOutput>(std::make_unique<BufferEncoder>(recorded));
+    auto mixer = engine.addMixer(FrameFormat::Mono);
+    engine.addMixerOutput(mixer, output);
+    auto input = engine.addInput<FileInput>(std::make_unique<BufferDecoder>(std::move(sound)), FileInput::Parameters());
+    engine.play(mixer, input, engine.addEffect<BypassEffect>(FrameFormat::Mono, FrameFormat::Mono));
+    opener.join();
+    REQUIRE(engine.isPlaying(input));
+    while(engine.isPlaying(input)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  REQUIRE(*std::max_element(recorded.getChannel(0).begin(), recorded.getChannel(0).end()) == Approx(0.5));
+}
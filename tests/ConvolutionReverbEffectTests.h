@@ -0,0 +1,201 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/ConvolutionReverbEffect.h>
+#include <ZAudio/EffectSerializer.h>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("BackgroundConvolution matches direct convolution") {
+  using namespace ZAudio;
+  constexpr size_t Length = 10000;
+
+  // first impulse is long enough to use background thread when fft is enabled
+  std::vector<std::vector<double>> impulses = {std::vector<double>(8500), std::vector<double>(300)};
+  for(auto& impulse : impulses) {
+    for(size_t i = 0; i < impulse.size(); i++) {
+      impulse[i] = std::exp(-0.0005 * i) * std::sin(i * 0.3 + impulse.size());
+    }
+  }
+
+  std::vector<sample_t> input(Length);
+  for(size_t i = 0; i < Length; i++) {
+    input[i] = std::sin(i * 0.013) * (i % 1000 < 500 ? 1. : 0.);
+  }
+
+  Tools::BackgroundConvolution convolution(impulses);
+  REQUIRE(convolution.getNumberOfConvolutions() == 2);
+  for(size_t n = 0; n < Length; n++) {
+    std::array<sample_t, 2> in = {input[n], -input[n]};
+    std::array<sample_t, 2> out;
+    convolution.process(in, out);
+
+    for(size_t j = 0; j < impulses.size(); j++) {
+      double expected = 0.;
+      for(size_t i = 0; i < impulses[j].size() && i <= n; i++) {
+        expected += impulses[j][i] * (j == 0 ? input[n - i] : -input[n - i]);
+      }
+      REQUIRE_THAT(out[j], Catch::Matchers::WithinAbs(expected, 0.0001));
+    }
+  }
+}
+
+#ifdef ZAUDIO_USE_FFT
+TEST_CASE("BackgroundConvolution in real time counts underruns instead of waiting") {
+  using namespace ZAudio;
+  constexpr size_t Partition = Tools::BackgroundConvolution::TailPartitionSize;
+  constexpr size_t Length = 12 * Partition;
+
+  std::vector<std::vector<double>> impulses = {std::vector<double>(400000)};
+  for(size_t i = 0; i < impulses[0].size(); i++) {
+    impulses[0][i] = std::exp(-0.0001 * i) * std::sin(i * 0.3);
+  }
+  // only first partition has sound, thread is never late at the first boundary, so lost partitions are silent anyway
+  std::vector<sample_t> input(Length);
+  for(size_t i = 0; i < Partition; i++) {
+    input[i] = std::sin(i * 0.013);
+  }
+  std::vector<sample_t> expected(Length);
+  Tools::BackgroundConvolution offline(impulses);
+  offline.process(std::array<std::span<const sample_t>, 1>{input}, std::array<std::span<sample_t>, 1>{expected});
+  REQUIRE(offline.getUnderruns() == 0);
+
+  // partition with silent tail has only head, which is processed without thread
+  std::vector<sample_t> headOnly(Length);
+  Tools::BackgroundConvolution head({std::vector<double>(impulses[0].begin(), impulses[0].begin() + 2 * Partition)});
+  head.process(std::array<std::span<const sample_t>, 1>{input}, std::array<std::span<sample_t>, 1>{headOnly});
+
+  // whole signal in one block is much faster than real time, so thread can be late, but other partitions stay aligned
+  std::vector<sample_t> output(Length);
+  Tools::BackgroundConvolution realTime(impulses);
+  realTime.setRealTime(true);
+  realTime.process(std::array<std::span<const sample_t>, 1>{input}, std::array<std::span<sample_t>, 1>{output});
+  size_t differentPartitions = 0;
+  for(size_t start = 0; start < Length; start += Partition) {
+    auto matches = [&](const std::vector<sample_t>& reference) {
+      for(size_t i = start; i < start + Partition; i++) {
+        if(std::abs(output[i] - reference[i]) > 0.0001) {
+          return false;
+        }
+      }
+      return true;
+    };
+    if(!matches(expected)) {
+      REQUIRE(matches(headOnly));
+      differentPartitions++;
+    }
+  }
+  REQUIRE(differentPartitions <= 2 * realTime.getUnderruns());
+}
+#endif
+
+TEST_CASE("ConvolutionReverbEffect") {
+  using namespace ZAudio;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  auto impulse = std::make_shared<SoundBuffer>(sampleRate, FrameFormat::Stereo, 10);
+  impulse->setSample(0, 0, 1.);
+  impulse->setSample(5, 1, 0.5);
+
+  ConvolutionReverbEffect effect(ConvolutionReverbEffect::Parameters("impulse.wav", FrameFormat::Stereo, Volume::linear(0.5), Volume::linear(1.)));
+  effect.setSampleRate(sampleRate);
+  REQUIRE(effect.setImpulses(impulse));
+  REQUIRE(effect.getTailTime() == 10);
+
+  // left input goes through impulse, right one through mirrored impulse
+  std::vector<std::array<sample_t, 2>> output;
+  for(size_t i = 0; i < 10; i++) {
+    std::array<sample_t, 2> in = {sample_t(i == 0), sample_t(i == 1)};
+    std::array<sample_t, 2> out;
+    effect.process(in, out);
+    output.push_back(out);
+  }
+  REQUIRE_THAT(output[0][0], Catch::Matchers::WithinAbs(1.5, 0.000001));
+  REQUIRE_THAT(output[1][1], Catch::Matchers::WithinAbs(1.5, 0.000001));
+  REQUIRE_THAT(output[5][1], Catch::Matchers::WithinAbs(0.25, 0.000001));
+  REQUIRE_THAT(output[6][0], Catch::Matchers::WithinAbs(0.25, 0.000001));
+  REQUIRE_THAT(output[3][0], Catch::Matchers::WithinAbs(0., 0.000001));
+
+  Tools::TreeDatabase database;
+  REQUIRE(Tools::EffectSerializer::instance().save(database, effect));
+  auto loaded = Tools::EffectSerializer::instance().load(database);
+  REQUIRE(loaded);
+  auto parameters = dynamic_cast<ConvolutionReverbEffect&>(*loaded.get()).getParameters();
+  REQUIRE(parameters.impulsePath == "impulse.wav");
+  REQUIRE(parameters.format == FrameFormat::Stereo);
+  REQUIRE_THAT(parameters.wet.linear(), Catch::Matchers::WithinAbs(0.5, 0.0001));
+}
+
+TEST_CASE("ConvolutionReverbEffect processBlock matches process") {
+  using namespace ZAudio;
+  const Frequency sampleRate = Frequency::Hz(48000);
+#ifdef ZAUDIO_USE_FFT
+  constexpr size_t ImpulseLength = 9000; // long enough for background thread
+#else
+  constexpr size_t ImpulseLength = ConvolutionReverbEffect::MaxImpulseLengthWithoutFFT;
+#endif
+  constexpr size_t Length = 20000;
+
+  auto impulse = std::make_shared<SoundBuffer>(sampleRate, FrameFormat::Stereo, ImpulseLength);
+  for(size_t i = 0; i < ImpulseLength; i++) {
+    impulse->setSample(i, 0, std::exp(-0.0005 * i) * std::sin(i * 0.3));
+    impulse->setSample(i, 1, std::exp(-0.0005 * i) * std::cos(i * 0.2));
+  }
+
+  for(FrameFormat format : {FrameFormat::Mono, FrameFormat::Stereo}) {
+    const size_t channels = Tools::numberOfChannels(format);
+    ConvolutionReverbEffect perFrame(ConvolutionReverbEffect::Parameters("impulse.wav", format, Volume::linear(0.5), Volume::linear(0.8)));
+    ConvolutionReverbEffect perBlock(ConvolutionReverbEffect::Parameters("impulse.wav", format, Volume::linear(0.5), Volume::linear(0.8)));
+    for(auto effect : {&perFrame, &perBlock}) {
+      effect->setSampleRate(sampleRate);
+      REQUIRE(effect->setImpulses(impulse));
+    }
+
+    std::vector<sample_t> left(Length);
+    std::vector<sample_t> right(Length);
+    for(size_t i = 0; i < Length; i++) {
+      left[i] = std::sin(i * 0.013) * (i % 1000 < 500 ? 1. : 0.);
+      right[i] = std::sin(i * 0.007);
+    }
+
+    // blocks of different lengths cross partition boundaries in the middle, processed in place
+    std::vector<sample_t> blockLeft = left;
+    std::vector<sample_t> blockRight = right;
+    for(size_t start = 0, frames = 1; start < Length; start += frames, frames = frames * 3 % 1021 + 1) {
+      frames = std::min(frames, Length - start);
+      AudioBlockView view = channels == 1 ? AudioBlockView(std::span(blockLeft).subspan(start, frames))
+                                          : AudioBlockView(std::span(blockLeft).subspan(start, frames), std::span(blockRight).subspan(start, frames));
+      perBlock.processBlock(view, view, frames);
+    }
+
+    for(size_t i = 0; i < Length; i++) {
+      std::array<sample_t, 2> in = {left[i], right[i]};
+      std::array<sample_t, 2> out;
+      perFrame.process(std::span(in).first(channels), std::span(out).first(channels));
+      REQUIRE_THAT(blockLeft[i], Catch::Matchers::WithinAbs(out[0], 0.000001));
+      if(channels == 2) {
+        REQUIRE_THAT(blockRight[i], Catch::Matchers::WithinAbs(out[1], 0.000001));
+      }
+    }
+  }
+}
+
+#ifndef ZAUDIO_USE_FFT
+TEST_CASE("ConvolutionReverbEffect refuses long impulse without fft") {
+  using namespace ZAudio;
+  const Frequency sampleRate = Frequency::Hz(48000);
+
+  ConvolutionReverbEffect effect(ConvolutionReverbEffect::Parameters("impulse.wav", FrameFormat::Mono, Volume::linear(0.5), Volume::linear(1.)));
+  effect.setSampleRate(sampleRate);
+  REQUIRE_FALSE(effect.setImpulses(std::make_shared<SoundBuffer>(sampleRate, FrameFormat::Mono, ConvolutionReverbEffect::MaxImpulseLengthWithoutFFT + 1)));
+  REQUIRE(effect.getTailTime() == 0);
+
+  // impulse accepted at its own sample rate is truncated when effect runs at higher one
+  ConvolutionReverbEffect resampled(ConvolutionReverbEffect::Parameters("impulse.wav", FrameFormat::Mono, Volume::linear(0.5), Volume::linear(1.)));
+  REQUIRE(resampled.setImpulses(std::make_shared<SoundBuffer>(Frequency::Hz(24000), FrameFormat::Mono, ConvolutionReverbEffect::MaxImpulseLengthWithoutFFT)));
+  resampled.setSampleRate(sampleRate);
+  REQUIRE(resampled.getTailTime() == ConvolutionReverbEffect::MaxImpulseLengthWithoutFFT);
+}
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/FIR_Filter.h>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("FIR_Filter matches direct convolution") {
+  using namespace ZAudio;
+  constexpr size_t Length = 3000;
+
+  std::vector<sample_t> input(Length);
+  for(size_t i = 0; i < Length; i++) {
+    input[i] = std::sin(i * 0.11) + 0.5 * std::sin(i * 2.3 + 1.);
+  }
+
+  // short filter is always direct, long one uses partitioned fft convolution when fft is enabled
+  for(size_t taps : {31, 1000}) {
+    std::vector<double> coefficients(taps);
+    for(size_t i = 0; i < taps; i++) {
+      coefficients[i] = std::exp(-0.005 * i) * std::cos(i * 0.7);
+    }
+
+    std::vector<sample_t> expected(Length, 0.);
+    for(size_t n = 0; n < Length; n++) {
+      for(size_t i = 0; i < taps && i <= n; i++) {
+        expected[n] += coefficients[i] * input[n - i];
+      }
+    }
+
+    Tools::FIR_Filter filter(coefficients);
+#ifdef ZAUDIO_USE_FFT
+    REQUIRE(filter.usesFFT() == (taps > Tools::FIR_Filter::FFTThreshold));
+#endif
+    std::vector<sample_t> result(input);
+    std::span<sample_t> samples(result);
+    filter.process(samples.first(1), samples.first(1));
+    filter.process(samples.subspan(1, 700), samples.subspan(1, 700));
+    for(size_t i = 701; i < Length; i++) {
+      result[i] = filter.process(input[i]);
+    }
+
+    for(size_t i = 0; i < Length; i++) {
+      REQUIRE_THAT(result[i], Catch::Matchers::WithinAbs(expected[i], 0.0001));
+    }
+  }
+}
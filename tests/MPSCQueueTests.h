@@ -0,0 +1,71 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include <ZAudio/MPSCQueue.h>
+
+
+TEST_CASE("MPSCQueue single thread") {
+  using namespace ZAudio::Tools;
+  MPSCQueue<int> queue(3);
+  REQUIRE(queue.getCapacity() == 4);
+  for(int i = 0; i < 4; i++) {
+    REQUIRE(queue.tryPush(i));
+  }
+  REQUIRE_FALSE(queue.tryPush(4));
+  for(int round = 0; round < 10; round++) {
+    auto v = queue.tryPop();
+    REQUIRE(v);
+    REQUIRE(*v == round);
+    REQUIRE(queue.tryPush(round + 4));
+  }
+
+  // value that wasn't pushed is left to caller
+  std::vector<int> big(10, 7);
+  MPSCQueue<std::vector<int>> vectors(1);
+  REQUIRE(vectors.getCapacity() == 2);
+  REQUIRE(vectors.tryPush(std::vector<int>(3)));
+  REQUIRE(vectors.tryPush(std::vector<int>(4)));
+  REQUIRE_FALSE(vectors.tryPush(std::move(big)));
+  REQUIRE(big.size() == 10);
+  REQUIRE(vectors.waitAndPop().size() == 3);
+  REQUIRE(vectors.waitAndPop().size() == 4);
+  REQUIRE_FALSE(vectors.tryPop());
+}
+
+TEST_CASE("MPSCQueue many writers") {
+  using namespace ZAudio::Tools;
+  constexpr int Writers = 4;
+  constexpr int PerWriter = 50000;
+  MPSCQueue<int> queue(16);
+  std::atomic_bool start(false);
+
+  std::vector<std::thread> writers;
+  for(int w = 0; w < Writers; w++) {
+    writers.emplace_back([&, w]() {
+      while(!start) {
+        std::this_thread::yield();
+      }
+      for(int i = 0; i < PerWriter; i++) {
+        queue.waitAndPush(w * PerWriter + i);
+      }
+    });
+  }
+  start = true;
+
+  // values of every writer come in order it pushed them
+  std::vector<int> last(Writers, -1);
+  for(int i = 0; i < Writers * PerWriter; i++) {
+    const int v = queue.waitAndPop();
+    const int writer = v / PerWriter;
+    REQUIRE(v % PerWriter == last[writer] + 1);
+    last[writer] = v % PerWriter;
+  }
+  for(auto& writer : writers) {
+    writer.join();
+  }
+  REQUIRE_FALSE(queue.tryPop());
+}
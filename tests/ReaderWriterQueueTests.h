@@ -2,6 +2,9 @@
 
 #include <thread>
 #include <atomic>
+#include <numeric>
+#include <span>
+#include <vector>
 
 #include "catch/catch.hpp"
 #include <ZAudio/ReaderWriterQueue.h>
@@ -135,3 +138,47 @@ TEST_CASE("ReaderWriterQueue two threads #2") {
   thread2.join();
   REQUIRE(out == in);
 }
+
+TEST_CASE("ReaderWriterQueue bulk push and pop") {
+  using namespace ZAudio::Tools;
+  ReaderWriterQueue<int> queue(5);
+  std::vector<int> in = {1, 2, 3, 4, 5, 6, 7};
+  REQUIRE(queue.tryPushMany(in) == 5);
+  REQUIRE(queue.getFreeSpace() == 0);
+  std::vector<int> out(3);
+  REQUIRE(queue.tryPopMany(out) == 3);
+  REQUIRE(out == std::vector<int>{1, 2, 3});
+  // wraps around end of buffer
+  REQUIRE(queue.tryPushMany(std::span<const int>(in).subspan(5)) == 2);
+  REQUIRE(queue.getReadable() == 4);
+  REQUIRE(queue.discard(1) == 1);
+  out.resize(10);
+  REQUIRE(queue.tryPopMany(out) == 3);
+  REQUIRE(std::vector<int>(out.begin(), out.begin() + 3) == std::vector<int>{5, 6, 7});
+  REQUIRE(queue.getReadable() == 0);
+
+  std::atomic_bool start(false);
+  const int n = 100000;
+  in.resize(n);
+  std::iota(in.begin(), in.end(), 0);
+  out.clear();
+  std::thread writer([&]() {
+    while(!start) {
+      std::this_thread::yield();
+    }
+    size_t i = 0;
+    while(i < in.size()) {
+      i += queue.tryPushMany(std::span<const int>(in).subspan(i, std::min<size_t>(i % 7 + 1, in.size() - i)));
+      std::this_thread::yield();
+    }
+  });
+  start = true;
+  std::vector<int> block(4);
+  while(out.size() < in.size()) {
+    const size_t got = queue.tryPopMany(block);
+    out.insert(out.end(), block.begin(), block.begin() + got);
+    std::this_thread::yield();
+  }
+  writer.join();
+  REQUIRE(out == in);
+}
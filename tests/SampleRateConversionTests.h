@@ -0,0 +1,144 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/SampleRateConversion.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("Resampler converts every channel of interleaved frames") {
+  using namespace ZAudio;
+  constexpr size_t Frames = 4000;
+  constexpr double Latency = 50.; // half of Medium filter length, in input samples
+
+  for(auto [in, out] : {std::pair{44100., 48000.}, std::pair{48000., 44100.}, std::pair{44100., 176400.}}) {
+    const std::array<double, 2> frequencies = {1000., 3000.};
+    std::vector<sample_t> input(2 * Frames);
+    for(size_t i = 0; i < Frames; i++) {
+      for(size_t channel = 0; channel < 2; channel++) {
+        input[2 * i + channel] = std::sin(2. * std::numbers::pi * frequencies[channel] * i / in);
+      }
+    }
+
+    Tools::Resampler resampler(2, Frequency::Hz(in), Frequency::Hz(out));
+    REQUIRE(resampler.usesPolyphase());
+    std::vector<sample_t> output(2 * resampler.getMaxOutputFrames(Frames));
+    const size_t written = resampler.process(input, output);
+    REQUIRE(written == static_cast<size_t>(std::ceil(Frames * out / in)));
+
+    // frame by frame processing gives the same result
+    Tools::Resampler frameResampler(2, Frequency::Hz(in), Frequency::Hz(out));
+    size_t j = 0;
+    for(size_t i = 0; i < Frames; i++) {
+      frameResampler.push(std::span<const sample_t>(input).subspan(2 * i, 2));
+      while(frameResampler.outReady()) {
+        std::array<sample_t, 2> frame;
+        frameResampler.get(frame);
+        REQUIRE(frame[0] == output[2 * j]);
+        REQUIRE(frame[1] == output[2 * j + 1]);
+        j++;
+      }
+    }
+    REQUIRE(j == written);
+
+    // skip beginning and end, where filter reaches outside of input
+    for(size_t i = 0; i < written; i++) {
+      const double time = i * in / out - Latency;
+      if(time < 2. * Latency || time > Frames - 2. * Latency) {
+        continue;
+      }
+      for(size_t channel = 0; channel < 2; channel++) {
+        REQUIRE_THAT(output[2 * i + channel], Catch::Matchers::WithinAbs(std::sin(2. * std::numbers::pi * frequencies[channel] * time / in), 0.001));
+      }
+    }
+  }
+}
+
+TEST_CASE("Resampler continues with sinc filter after frequency change") {
+  using namespace ZAudio;
+  const Frequency In = Frequency::Hz(44100.);
+  const Frequency Out = Frequency::Hz(48000.);
+
+  auto input = [&In](size_t i) -> sample_t {
+    return std::sin(2. * std::numbers::pi * 500. * i / In.Hz());
+  };
+
+  auto process = [&](Tools::Resampler& resampler, bool switchToSinc) {
+    std::vector<sample_t> output;
+    for(size_t i = 0; i < 3000; i++) {
+      if(switchToSinc && i == 1000) {
+        // same ratio, so output should continue without change
+        resampler.setOutSampleRateNoFilterUpdate(Out);
+        REQUIRE_FALSE(resampler.usesPolyphase());
+      }
+      const sample_t sample = input(i);
+      resampler.push(std::span<const sample_t>(&sample, 1));
+      while(resampler.outReady()) {
+        output.push_back(0.);
+        resampler.get(std::span<sample_t>(&output.back(), 1));
+      }
+    }
+    return output;
+  };
+
+  Tools::Resampler polyphase(1, In, Out);
+  Tools::Resampler switched(1, In, Out);
+  REQUIRE(switched.usesPolyphase());
+  const auto expected = process(polyphase, false);
+  const auto result = process(switched, true);
+  // sinc filter counts position in floating point, so last output may differ
+  REQUIRE(result.size() + 1 >= expected.size());
+  for(size_t i = 0; i < expected.size() - 1; i++) {
+    REQUIRE_THAT(result[i], Catch::Matchers::WithinAbs(expected[i], 0.001));
+  }
+}
+
+TEST_CASE("Sinc sample rate conversion keeps amplitude") {
+  using namespace ZAudio;
+  SoundBuffer in(Frequency::Hz(44100.), FrameFormat::Mono, 10000);
+  auto samples = in.getChannel(0);
+  for(size_t i = 0; i < samples.size(); i++) {
+    samples[i] = std::sin(2. * std::numbers::pi * 1000. * i / 44100.);
+  }
+
+  const SoundBuffer out = Tools::convertSampleRateSinc(in, Frequency::Hz(48000.));
+  sample_t peak = 0.;
+  for(auto sample : out.getChannel(0).subspan(1000, 8000)) {
+    peak = std::max(peak, std::abs(sample));
+  }
+  REQUIRE_THAT(peak, Catch::Matchers::WithinAbs(1., 0.001));
+}
+
+TEST_CASE("Sinc sample rate conversion on worker pool") {
+  using namespace ZAudio;
+  // longer than one chunk, so channels are split
+  SoundBuffer in(Frequency::Hz(44100.), FrameFormat::Stereo, Tools::SampleRateConversion::ChunkLength + 5000);
+  for(size_t channel = 0; channel < 2; channel++) {
+    auto samples = in.getChannel(channel);
+    for(size_t i = 0; i < samples.size(); i++) {
+      samples[i] = std::sin(i * 0.05 * (channel + 1)) + 0.3 * std::sin(i * 1.7);
+    }
+  }
+
+  const SoundBuffer expected = Tools::convertSampleRateSinc(in, Frequency::Hz(48000.));
+
+  ThreadTools::WorkerPool pool(3);
+  std::vector<double> progress;
+  const SoundBuffer result = Tools::convertSampleRateSinc(in, Frequency::Hz(48000.), Tools::SampleRateConversion::DefaultFilterRadius, nullptr, &pool, [&progress](double v) {
+    progress.push_back(v);
+  });
+
+  REQUIRE(result.getLength() == expected.getLength());
+  for(size_t channel = 0; channel < 2; channel++) {
+    for(size_t i = 0; i < result.getLength(); i++) {
+      REQUIRE(result.getSample(i, channel) == expected.getSample(i, channel));
+    }
+  }
+  // 2 chunks per channel
+  REQUIRE(progress.size() == 4);
+  REQUIRE(std::is_sorted(progress.begin(), progress.end()));
+  REQUIRE(progress.back() == 1.);
+}
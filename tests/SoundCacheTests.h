@@ -0,0 +1,233 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/BufferDecoder.h>
+#include <ZAudio/SoundCache.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+namespace SoundCacheTests {
+
+// "files" are generated, name of file is its sample rate
+inline ZAudio::ResultValue<std::unique_ptr<ZAudio::AudioDecoder>> loadGenerated(const std::filesystem::path& path) {
+  using namespace ZAudio;
+  const double sampleRate = std::stod(path.stem().string());
+  SoundBuffer buffer(Frequency::Hz(sampleRate), FrameFormat::Stereo, 4410);
+  for(size_t i = 0; i < buffer.getLength(); i++) {
+    buffer.setSample(i, 0, std::sin(i * 0.1));
+    buffer.setSample(i, 1, std::cos(i * 0.03));
+  }
+  return std::unique_ptr<AudioDecoder>(std::make_unique<BufferDecoder>(std::move(buffer)));
+}
+
+} // namespace SoundCacheTests
+
+TEST_CASE("SoundCache converts PreBuffer sounds to target sample rate once") {
+  using namespace ZAudio;
+  const Frequency Target = Frequency::Hz(48000.);
+
+  SoundCache cache;
+  cache.addLoadingFunction(".gen", SoundCacheTests::loadGenerated);
+  cache.setTargetSampleRate(Target);
+  auto id = cache.add("44100.gen");
+  auto matching = cache.add("48000.gen");
+  REQUIRE(id);
+  REQUIRE(matching);
+
+  // original of converted sound is not kept
+  const size_t frameSize = 2 * sizeof(sample_t);
+  REQUIRE(cache.getStatistics().memoryUsage == (4800 + 4410) * frameSize);
+
+  auto converted = cache.getBuffer(*id, Target);
+  REQUIRE(converted->getSampleRate() == Target);
+  REQUIRE(converted == cache.getBuffer(*id, Target));
+  REQUIRE(cache.getStatistics().misses == 0);
+  REQUIRE(cache.getBuffer(*id)->getSampleRate() == Frequency::Hz(44100.));
+  REQUIRE(cache.getStatistics().misses == 1);
+
+  // converting to other sample rate keeps only the new copy next to the converted ones
+  REQUIRE(cache.getBuffer(*id, Frequency::Hz(22050.))->getLength() == 2205);
+  REQUIRE(cache.getStatistics().memoryUsage == (4800 + 2205 + 4410) * frameSize);
+  REQUIRE(cache.getBuffer(*matching, Target) == cache.getBuffer(*matching));
+
+  // FileInput plays converted samples without resampling them again
+  auto input = cache.getSound(*id);
+  REQUIRE(input);
+  input->setSampleRate(Target);
+  for(size_t i = 0; i < converted->getLength(); i++) {
+    std::array<sample_t, 2> frame;
+    input->get(frame);
+    REQUIRE(frame[0] == converted->getSample(i, 0));
+    REQUIRE(frame[1] == converted->getSample(i, 1));
+  }
+}
+
+TEST_CASE("SoundCache evicts least recently used PreBuffer sounds over memory budget") {
+  using namespace ZAudio;
+  SoundCache cache;
+  cache.addLoadingFunction(".gen", SoundCacheTests::loadGenerated);
+  auto first = cache.add("44100.gen");
+  REQUIRE(first);
+  const size_t soundSize = cache.getStatistics().memoryUsage;
+  REQUIRE(soundSize == 4410 * 2 * sizeof(sample_t));
+  cache.setMemoryBudget(2 * soundSize);
+
+  auto second = cache.add("44100.gen");
+  auto third = cache.add("44100.gen");
+  auto stats = cache.getStatistics();
+  REQUIRE(stats.evictions == 1);
+  REQUIRE(stats.memoryUsage == 2 * soundSize);
+
+  // first was evicted, so it's loaded again and second is evicted instead
+  REQUIRE(cache.getBuffer(*first));
+  stats = cache.getStatistics();
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.hits == 0);
+  REQUIRE(stats.evictions == 2);
+
+  // sound being played is not evicted
+  auto input = cache.getSound(*third);
+  REQUIRE(cache.getStatistics().hits == 1);
+  REQUIRE(cache.getBuffer(*second));
+  stats = cache.getStatistics();
+  REQUIRE(stats.evictions == 3);
+  REQUIRE(stats.memoryUsage == 2 * soundSize);
+  REQUIRE(cache.getBuffer(*third));
+  REQUIRE(cache.getStatistics().hits == 2);
+
+  cache.remove(*third);
+  REQUIRE_FALSE(cache.getBuffer(*third));
+  REQUIRE(cache.getStatistics().memoryUsage == soundSize);
+}
+
+TEST_CASE("SoundCache adds batch of sounds on worker pool") {
+  using namespace ZAudio;
+  SoundCache cache;
+  cache.addLoadingFunction(".gen", SoundCacheTests::loadGenerated);
+  cache.addLoadingFunction(".bad", [](const std::filesystem::path&) -> ResultValue<std::unique_ptr<AudioDecoder>> {
+    return Result::error("broken file");
+  });
+  cache.setTargetSampleRate(Frequency::Hz(48000.));
+
+  std::vector<std::filesystem::path> paths;
+  for(size_t i = 0; i < 20; i++) {
+    paths.push_back(i % 2 == 0 ? "44100.gen" : "48000.gen");
+  }
+  paths[5] = "1.bad";
+  paths[7] = "1.unknown";
+
+  ThreadTools::WorkerPool pool(3);
+  std::vector<size_t> reported;
+  auto results = cache.addBatch(paths, SoundCache::OpenMode::PreBuffer, &pool, [&reported](size_t i, const SoundCache::BatchResult&) {
+    reported.push_back(i);
+  });
+
+  REQUIRE(results.size() == paths.size());
+  std::sort(reported.begin(), reported.end());
+  for(size_t i = 0; i < paths.size(); i++) {
+    REQUIRE(reported[i] == i);
+    if(i == 5 || i == 7) {
+      REQUIRE_FALSE(results[i].id);
+      REQUIRE_FALSE(results[i].error.empty());
+      continue;
+    }
+    REQUIRE(results[i].id);
+    REQUIRE(results[i].id->get() == i);
+    // generated sounds have 4410 frames
+    REQUIRE(cache.getBuffer(*results[i].id, Frequency::Hz(48000.))->getLength() == (i % 2 == 0 ? 4800 : 4410));
+  }
+  REQUIRE(results[5].error == "broken file");
+  REQUIRE(cache.getStatistics().misses == 0);
+
+  // stream sounds are only checked for loading function
+  auto streamed = cache.addBatch({"44100.gen", "1.unknown"}, SoundCache::OpenMode::Stream);
+  REQUIRE(streamed[0].id);
+  REQUIRE_FALSE(streamed[1].id);
+  REQUIRE(cache.getSound(*streamed[0].id));
+}
+
+TEST_CASE("ChunkCacheDecoder decodes sound through shared chunk cache") {
+  using namespace ZAudio;
+  auto makeDecoder = []() {
+    SoundBuffer buffer(Frequency::Hz(44100.), FrameFormat::Stereo, 20000);
+    for(size_t i = 0; i < buffer.getLength(); i++) {
+      buffer.setSample(i, 0, i);
+      buffer.setSample(i, 1, -double(i));
+    }
+    return std::make_unique<BufferDecoder>(std::move(buffer));
+  };
+  auto cache = std::make_shared<DecodedChunkCache>(2);
+  ChunkCacheDecoder decoder(makeDecoder(), 0, cache);
+  auto reference = makeDecoder();
+  decoder.setLooped(true);
+  reference->setLooped(true);
+  REQUIRE(decoder.getLength() == 20000);
+
+  // sound has 3 chunks, so looping over it also evicts
+  std::array<sample_t, 2> frame;
+  std::array<sample_t, 2> expected;
+  for(size_t i = 0; i < 45000; i++) {
+    REQUIRE(decoder.get(frame));
+    reference->get(expected);
+    REQUIRE(frame == expected);
+  }
+  REQUIRE(cache->size() == 2);
+
+  // second decoder of the same sound gets decoded chunk from cache
+  ChunkCacheDecoder second(makeDecoder(), 0, cache);
+  second.seek(decoder.getPosition());
+  REQUIRE(second.get(frame));
+  REQUIRE(frame[0] == decoder.getPosition());
+
+  decoder.setLooped(false);
+  decoder.seek(19999);
+  REQUIRE(decoder.get(frame));
+  REQUIRE_FALSE(decoder.get(frame));
+  REQUIRE_FALSE(decoder.errorOccured());
+}
+
+TEST_CASE("SoundCache keeps Compressed sounds in memory") {
+  using namespace ZAudio;
+  // "encoded" file holds only sample rate of generated sound
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "ZAudioSoundCacheTest.mem";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "44100";
+  }
+
+  SoundCache cache;
+  cache.addMemoryLoadingFunction(".mem", [](std::shared_ptr<const std::vector<uint8_t>> data) {
+    return SoundCacheTests::loadGenerated(std::string(data->begin(), data->end()) + ".gen");
+  });
+  REQUIRE_FALSE(cache.add(path, SoundCache::OpenMode::PreBuffer));
+  auto id = cache.add(path, SoundCache::OpenMode::Compressed);
+  std::filesystem::remove(path);
+  REQUIRE(id);
+  // budget is only for PreBuffer sounds, Compressed one stays in memory
+  cache.setMemoryBudget(0);
+  REQUIRE(cache.getStatistics().memoryUsage == 0);
+  REQUIRE(cache.getStatistics().compressedMemoryUsage == 5);
+  REQUIRE_FALSE(cache.getBuffer(*id));
+
+  // file is not needed anymore
+  auto input = cache.getSound(*id);
+  REQUIRE(input);
+  input->setSampleRate(Frequency::Hz(44100.));
+  auto reference = SoundCacheTests::loadGenerated("44100.gen");
+  for(size_t i = 0; i < 100; i++) {
+    std::array<sample_t, 2> frame;
+    std::array<sample_t, 2> expected;
+    input->get(frame);
+    reference.get()->get(expected);
+    REQUIRE(frame[0] == Approx(expected[0]).margin(1e-6));
+    REQUIRE(frame[1] == Approx(expected[1]).margin(1e-6));
+  }
+
+  cache.remove(*id);
+  REQUIRE(cache.getStatistics().compressedMemoryUsage == 0);
+  REQUIRE_FALSE(cache.getSound(*id));
+}
@@ -1,10 +1,20 @@
 #define CATCH_CONFIG_MAIN
 #include "catch/catch.hpp"
 
+#include "AnalogFilterTests.h"
+#include "AudioBlockTests.h"
+#include "AudioDecoderTests.h"
+#include "AudioEngineTests.h"
 #include "CircularBufferTests.h"
 #include "CommonTypesTests.h"
+#include "ConvolutionReverbEffectTests.h"
 #include "EffectsIOTests.h"
+#include "FIR_FilterTests.h"
 #include "MathTests.h"
+#include "MPSCQueueTests.h"
 #include "ReaderWriterQueueTests.h"
+#include "SampleRateConversionTests.h"
+#include "SoundCacheTests.h"
 #include "StringToolsTests.h"
+#include "ThreadToolsTests.h"
 #include "TwoDimVectorTests.h"
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "catch/catch.hpp"
+
+#include <ZAudio/ThreadTools.h>
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("WorkerPool parallelFor") {
+  using namespace ZAudio::ThreadTools;
+  for(size_t threads : {0, 1, 4}) {
+    WorkerPool pool(threads);
+    REQUIRE(pool.getNumberOfThreads() == threads);
+    for(size_t count : {0, 1, 7, 1000}) {
+      for(int repeat = 0; repeat < 20; repeat++) {
+        std::vector<int> done(count, 0);
+        std::atomic<size_t> calls{0};
+        pool.parallelFor(count, [&](size_t i) {
+          done[i]++;
+          calls++;
+        });
+        REQUIRE(calls == count);
+        REQUIRE(std::accumulate(done.begin(), done.end(), size_t(0)) == count);
+        REQUIRE(std::all_of(done.begin(), done.end(), [](int d) { return d == 1; }));
+      }
+    }
+  }
+}
+
+TEST_CASE("RenderSignal") {
+  using namespace ZAudio::ThreadTools;
+  RenderSignal signal;
+  signal.requestFrames(100);
+  signal.requestFrames(28);
+  REQUIRE(signal.wait() == 128);
+
+  signal.notify();
+  REQUIRE(signal.wait() == 0);
+
+  signal.setRatio(0.5);
+  signal.requestFrames(3);
+  REQUIRE(signal.wait() == 1);
+  signal.requestFrames(3);
+  REQUIRE(signal.wait() == 2);
+
+  signal.setRatio(1.);
+  signal.clear();
+  size_t received = 0;
+  std::thread requester([&]() {
+    for(int i = 0; i < 1000; i++) {
+      signal.requestFrames(64);
+    }
+  });
+  while(received < 64000) {
+    received += signal.wait();
+  }
+  requester.join();
+  REQUIRE(received == 64000);
+}
+
+TEST_CASE("IOExecutor serves most urgent stream first") {
+  using namespace ZAudio::ThreadTools;
+  struct TestStream : IOExecutor::Stream {
+    int id = 0;
+    double seconds = 0.;
+    std::atomic_int parts{1};
+    std::vector<int>* order = nullptr;
+    std::atomic_bool* started = nullptr;
+    std::atomic_bool* gate = nullptr;
+    TestStream(int id_p, double seconds_p, int parts_p, std::vector<int>* order_p) : id(id_p), seconds(seconds_p), parts(parts_p), order(order_p) {}
+    double getBufferedSeconds() const override {
+      return seconds;
+    }
+    bool service() override {
+      if(started) {
+        *started = true;
+      }
+      while(gate && !*gate) {
+        std::this_thread::yield();
+      }
+      order->push_back(id);
+      return --parts > 0;
+    }
+  };
+
+  IOExecutor executor(1);
+  REQUIRE(executor.getNumberOfThreads() == 1);
+  std::vector<int> order;
+  std::atomic_bool started{false};
+  std::atomic_bool gate{false};
+  TestStream blocking(0, 0., 1, &order);
+  blocking.started = &started;
+  blocking.gate = &gate;
+  TestStream slow(1, 2., 1, &order);
+  TestStream urgent(2, 0.5, 2, &order);
+  TestStream middle(3, 1., 1, &order);
+
+  executor.request(blocking);
+  while(!started) {
+    std::this_thread::yield();
+  }
+  // only thread is busy with blocking stream, so others are queued together
+  executor.request(slow);
+  executor.request(middle);
+  executor.request(urgent);
+  gate = true;
+  for(auto* stream : {&blocking, &slow, &urgent, &middle}) {
+    while(stream->parts > 0) {
+      std::this_thread::yield();
+    }
+    executor.remove(*stream);
+  }
+  REQUIRE(order == std::vector<int>{0, 2, 2, 3, 1});
+
+  executor.setNumberOfThreads(3);
+  REQUIRE(executor.getNumberOfThreads() == 3);
+  order.clear();
+  slow.parts = 1;
+  executor.request(slow);
+  while(slow.parts > 0) {
+    std::this_thread::yield();
+  }
+  executor.remove(slow);
+  REQUIRE(order == std::vector<int>{1});
+  executor.setNumberOfThreads(0);
+  REQUIRE(executor.getNumberOfThreads() == 0);
+}
+
+TEST_CASE("SeqLock reader never sees half written value") {
+  using namespace ZAudio::ThreadTools;
+  struct Value {
+    uint64_t a = 0;
+    uint64_t b = 0;
+    uint64_t c = 0;
+  };
+  SeqLock<Value> lock;
+  REQUIRE(lock.load().a == 0);
+
+  std::atomic_bool stop{false};
+  std::thread writer([&]() {
+    for(uint64_t i = 1; !stop; i++) {
+      lock.store({i, i * 2, i * 3});
+    }
+  });
+  uint64_t last = 0;
+  for(int i = 0; i < 100000; i++) {
+    const Value value = lock.load();
+    REQUIRE(value.b == value.a * 2);
+    REQUIRE(value.c == value.a * 3);
+    REQUIRE(value.a >= last);
+    last = value.a;
+  }
+  stop = true;
+  writer.join();
+}